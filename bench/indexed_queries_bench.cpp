@@ -0,0 +1,103 @@
+#include "../include/database.hpp"
+#include "../include/Logger.hpp"
+#include <algorithm>   // Для std::sort
+#include <chrono>      // Для замеров времени
+#include <iostream>    // Для вывода результатов
+#include <set>         // Для клиентской фильтрации по кабинетам
+#include <string>      // Для работы со строками
+
+// Бенчмарк выборок по корпусу/этажу, назначению кабинета и ответственному.
+// Сравнивает индексные запросы Database с прежним способом: полная выборка
+// через searchEquipment и фильтрация на стороне клиента.
+//
+// Запуск: indexed_queries_bench [число_записей] [путь_к_БД]
+// По умолчанию 1 000 000 записей в БД в памяти.
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Выполняет функцию несколько раз и возвращает медианное время в миллисекундах
+template <typename Fn>
+double medianMs(int repeats, Fn&& fn) {
+    std::vector<double> samples;
+    for (int i = 0; i < repeats; ++i) {
+        auto start = Clock::now();
+        fn();
+        samples.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+void report(const std::string& name, std::size_t rows, double indexedMs, double scanMs) {
+    std::cout << name << ": строк " << rows << ", индекс " << indexedMs << " мс, "
+              << "полный просмотр " << scanMs << " мс, ускорение x" << scanMs / indexedMs << "\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    long long count = argc > 1 ? std::stoll(argv[1]) : 1000000;
+    std::string path = argc > 2 ? argv[2] : ":memory:";
+
+    Logger logger("indexed_queries_bench.log", Logger::WARNING);
+    Database db(path, logger);
+    if (!db.initialize()) {
+        std::cerr << "Ошибка инициализации базы данных!" << std::endl;
+        return 1;
+    }
+
+    // Заполнение: 25 кабинетов из Classrooms, 1000 ответственных
+    auto loadStart = Clock::now();
+    bool loaded = db.execute(
+        "WITH RECURSIVE seq(n) AS (SELECT 1 UNION ALL SELECT n + 1 FROM seq WHERE n < " + std::to_string(count) + ") "
+        "INSERT INTO Equipment (name, quantity, inventory_number, room, responsible) "
+        "SELECT 'Предмет ' || n, n % 50, 'INV-' || n, "
+        "(SELECT room_number FROM Classrooms WHERE id = 1 + n % 25), 'МОЛ ' || (n % 1000) FROM seq;");
+    if (!loaded || !db.execute("ANALYZE;")) {
+        std::cerr << "Ошибка заполнения базы данных!" << std::endl;
+        return 1;
+    }
+    std::cout << "Загружено " << count << " записей за "
+              << std::chrono::duration<double>(Clock::now() - loadStart).count() << " с\n";
+
+    const int repeats = 5;
+
+    // Корпус А, этаж 2: кабинеты 10-17
+    std::size_t rows = 0;
+    double indexed = medianMs(repeats, [&] { rows = db.findEquipmentByLocation("A", 2).size(); });
+    double scan = medianMs(1, [&] {
+        const std::set<std::string> floorRooms = {"10", "11", "12", "13", "14", "15", "16", "17"};
+        std::size_t matched = 0;
+        for (const auto& row : db.searchEquipment("")) {
+            matched += floorRooms.count(row[3]);
+        }
+        rows = std::max(rows, matched);
+    });
+    report("Корпус A, этаж 2", rows, indexed, scan);
+
+    // Кабинеты химии: 13 и 22
+    indexed = medianMs(repeats, [&] { rows = db.findEquipmentByPurpose("Химия").size(); });
+    scan = medianMs(1, [&] {
+        std::size_t matched = 0;
+        for (const auto& row : db.searchEquipment("")) {
+            matched += (row[3] == "13" || row[3] == "22") ? 1 : 0;
+        }
+        rows = std::max(rows, matched);
+    });
+    report("Назначение \"Химия\"", rows, indexed, scan);
+
+    // Один ответственный из 1000
+    indexed = medianMs(repeats, [&] { rows = db.findEquipmentByResponsible("МОЛ 42").size(); });
+    scan = medianMs(1, [&] {
+        std::size_t matched = 0;
+        for (const auto& row : db.searchEquipment("")) {
+            matched += row[4] == "МОЛ 42" ? 1 : 0;
+        }
+        rows = std::max(rows, matched);
+    });
+    report("Ответственный \"МОЛ 42\"", rows, indexed, scan);
+
+    return 0;
+}
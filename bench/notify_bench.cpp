@@ -0,0 +1,68 @@
+#include "../include/database.hpp"
+#include "../include/Logger.hpp"
+#include <atomic>      // Для счетчика доставленных событий
+#include <chrono>      // Для замеров времени
+#include <iostream>    // Для вывода результатов
+#include <string>      // Для работы со строками
+
+// Бенчмарк стоимости записи при 0, 1 и 100 подписчиках на изменения.
+// Каждая операция - отдельная транзакция addEquipment; время включает
+// только запись, доставка идет в отдельном потоке и ожидается после замера.
+//
+// Запуск: notify_bench [число_записей]
+// По умолчанию 20 000 записей в БД в памяти.
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Возвращает время записи count единиц оборудования в миллисекундах
+double measureWrites(int subscribers, int count, long long& delivered) {
+    Logger logger("notify_bench.log", Logger::WARNING);
+    Database db(":memory:", logger);
+    if (!db.initialize()) {
+        return -1;
+    }
+
+    std::atomic<long long> events{0};
+    for (int i = 0; i < subscribers; ++i) {
+        // Подписчики на разные кабинеты: фильтр отбирает часть событий
+        std::string room = i == 0 ? std::string() : std::to_string(i % 30);
+        db.subscribe("Equipment", [&events](const std::vector<ChangeEvent>& batch) {
+            events += static_cast<long long>(batch.size());
+        }, room);
+    }
+
+    auto start = Clock::now();
+    for (int i = 0; i < count; ++i) {
+        db.addEquipment("Стол", 1, "BENCH-" + std::to_string(i), std::to_string(i % 30), "Иванов И.И.");
+    }
+    double elapsed = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    db.waitForNotifications();
+    delivered = events;
+    return elapsed;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int count = argc > 1 ? std::stoi(argv[1]) : 20000;
+
+    double baseline = 0;
+    for (int subscribers : {0, 1, 100}) {
+        long long delivered = 0;
+        double ms = measureWrites(subscribers, count, delivered);
+        if (ms < 0) {
+            std::cerr << "Не удалось инициализировать БД\n";
+            return 1;
+        }
+        if (subscribers == 0) {
+            baseline = ms;
+        }
+        std::cout << "Подписчиков: " << subscribers << ", записей: " << count << ", " << ms << " мс ("
+                  << count / (ms / 1000.0) << " записей/с), накладные расходы "
+                  << (ms / baseline - 1.0) * 100.0 << "%, доставлено событий: " << delivered << "\n";
+    }
+    return 0;
+}
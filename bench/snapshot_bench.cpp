@@ -0,0 +1,165 @@
+#include "../include/database.hpp"
+#include "../include/EquipmentSnapshot.hpp"
+#include "../include/Logger.hpp"
+#include <sqlite3.h>   // Эквивалентные запросы SQL на отдельном соединении
+#include <algorithm>   // Для std::sort
+#include <chrono>      // Для замеров времени
+#include <cstdio>      // Для std::remove
+#include <iostream>    // Для вывода результатов
+#include <string>      // Для работы со строками
+#include <vector>      // Для замеров
+
+// Бенчмарк столбцового снимка EquipmentSnapshot против эквивалентных запросов SQLite:
+// отбор с итогами, отбор по корпусу и группировка по назначению кабинета.
+// Также сравнивает обновление снимка по изменениям с полной загрузкой.
+//
+// Запуск: snapshot_bench [число_записей] [путь_к_БД]
+// По умолчанию 1 000 000 записей в файле snapshot_bench.db (удаляется после замера).
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Выполняет функцию несколько раз и возвращает медианное время в миллисекундах
+template <typename Fn>
+double medianMs(int repeats, Fn&& fn) {
+    std::vector<double> samples;
+    for (int i = 0; i < repeats; ++i) {
+        auto start = Clock::now();
+        fn();
+        samples.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+// Выполняет запрос и возвращает сумму первых двух столбцов всех строк результата
+EquipmentSnapshot::Totals runSql(sqlite3* db, const char* sql) {
+    EquipmentSnapshot::Totals totals;
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+        std::cerr << "Ошибка SQL: " << sqlite3_errmsg(db) << "\n";
+        return totals;
+    }
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        totals.items += static_cast<std::size_t>(sqlite3_column_int64(stmt, 0));
+        totals.quantity += sqlite3_column_int64(stmt, 1);
+    }
+    sqlite3_finalize(stmt);
+    return totals;
+}
+
+void report(const std::string& name, const EquipmentSnapshot::Totals& totals, bool same, double snapshotMs,
+            double sqlMs) {
+    std::cout << name << ": строк " << totals.items << ", количество " << totals.quantity
+              << (same ? "" : " (РАСХОЖДЕНИЕ С SQL)") << ", снимок " << snapshotMs << " мс, SQLite " << sqlMs
+              << " мс, ускорение x" << sqlMs / snapshotMs << "\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    long long count = argc > 1 ? std::stoll(argv[1]) : 1000000;
+    std::string path = argc > 2 ? argv[2] : "snapshot_bench.db";
+    for (const char* suffix : {"", "-wal", "-shm"}) {
+        std::remove((path + suffix).c_str());
+    }
+
+    Logger logger("snapshot_bench.log", Logger::WARNING);
+    {
+        Database db(path, logger);
+        if (!db.initialize()) {
+            std::cerr << "Ошибка инициализации базы данных!" << std::endl;
+            return 1;
+        }
+
+        // Заполнение: 25 кабинетов из Classrooms, 1000 ответственных, количество 0-49
+        bool loaded = db.execute(
+            "WITH RECURSIVE seq(n) AS (SELECT 1 UNION ALL SELECT n + 1 FROM seq WHERE n < " + std::to_string(count) +
+            ") INSERT INTO Equipment (name, quantity, inventory_number, room, responsible) "
+            "SELECT 'Предмет ' || n, n % 50, 'INV-' || n, "
+            "(SELECT room_number FROM Classrooms WHERE id = 1 + n % 25), 'МОЛ ' || (n % 1000) FROM seq;");
+        if (!loaded || !db.execute("ANALYZE;")) {
+            std::cerr << "Ошибка заполнения базы данных!" << std::endl;
+            return 1;
+        }
+
+        sqlite3* sql;
+        if (sqlite3_open(path.c_str(), &sql) != SQLITE_OK) {
+            std::cerr << "Не удалось открыть БД: " << path << std::endl;
+            return 1;
+        }
+
+        EquipmentSnapshot snapshot(db);
+        double loadMs = medianMs(1, [&] { snapshot.load(); });
+        std::cout << "Снимок " << snapshot.size() << " записей загружен за " << loadMs << " мс\n";
+
+        const int repeats = 5;
+        EquipmentSnapshot::Totals fromSnapshot, fromSql;
+
+        // Запрос панели: количество больше 10 в кабинетах химии у одного МОЛ
+        EquipmentSnapshot::Filter dashboard;
+        dashboard.purpose = "Химия";
+        dashboard.responsible = "МОЛ 11";
+        dashboard.min_quantity = 11;
+        double snapshotMs = medianMs(repeats, [&] { fromSnapshot = snapshot.totals(dashboard); });
+        double sqlMs = medianMs(repeats, [&] {
+            fromSql = runSql(sql, "SELECT count(*), total(e.quantity) FROM Equipment AS e "
+                                  "JOIN Classrooms AS c ON c.id = e.classroom_id "
+                                  "WHERE e.quantity > 10 AND c.purpose = 'Химия' AND e.responsible = 'МОЛ 11';");
+        });
+        report("Химия, МОЛ 11, количество > 10", fromSnapshot,
+               fromSnapshot.items == fromSql.items && fromSnapshot.quantity == fromSql.quantity, snapshotMs, sqlMs);
+
+        // Количество больше 10 в корпусе A
+        EquipmentSnapshot::Filter building;
+        building.building = "A";
+        building.min_quantity = 11;
+        snapshotMs = medianMs(repeats, [&] { fromSnapshot = snapshot.totals(building); });
+        sqlMs = medianMs(repeats, [&] {
+            fromSql = runSql(sql, "SELECT count(*), total(e.quantity) FROM Equipment AS e "
+                                  "JOIN Classrooms AS c ON c.id = e.classroom_id "
+                                  "WHERE e.quantity > 10 AND c.building = 'A';");
+        });
+        report("Корпус A, количество > 10", fromSnapshot,
+               fromSnapshot.items == fromSql.items && fromSnapshot.quantity == fromSql.quantity, snapshotMs, sqlMs);
+
+        // Итоги по назначению кабинета для количества больше 40
+        EquipmentSnapshot::Filter large;
+        large.min_quantity = 41;
+        snapshotMs = medianMs(repeats, [&] {
+            fromSnapshot = {};
+            for (const auto& group : snapshot.totalsBy(EquipmentSnapshot::PURPOSE, large)) {
+                fromSnapshot.items += group.second.items;
+                fromSnapshot.quantity += group.second.quantity;
+            }
+        });
+        sqlMs = medianMs(repeats, [&] {
+            fromSql = runSql(sql, "SELECT count(*), total(e.quantity) FROM Equipment AS e "
+                                  "LEFT JOIN Classrooms AS c ON c.id = e.classroom_id "
+                                  "WHERE e.quantity > 40 GROUP BY c.purpose;");
+        });
+        report("Группировка по назначению, количество > 40", fromSnapshot,
+               fromSnapshot.items == fromSql.items && fromSnapshot.quantity == fromSql.quantity, snapshotMs, sqlMs);
+
+        // Обновление после 1000 изменений: по отслеживанию изменений и полной загрузкой
+        db.execute("BEGIN;");
+        for (int i = 1; i <= 1000; ++i) {
+            db.updateEquipment("INV-" + std::to_string(i * 997 % count + 1), 49, "13", "МОЛ 11");
+        }
+        db.execute("COMMIT;");
+        double refreshMs = medianMs(1, [&] { snapshot.refresh(); });
+        double reloadMs = medianMs(1, [&] { snapshot.load(); });
+        std::cout << "Обновление после 1000 изменений: " << refreshMs << " мс, полная загрузка " << reloadMs
+                  << " мс\n";
+
+        sqlite3_close(sql);
+    }
+
+    if (argc <= 2) {
+        for (const char* suffix : {"", "-wal", "-shm"}) {
+            std::remove((path + suffix).c_str());
+        }
+    }
+    return 0;
+}
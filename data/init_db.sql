@@ -5,7 +5,8 @@ CREATE TABLE IF NOT EXISTS Equipment (
     quantity INTEGER NOT NULL,       -- Количество
     inventory_number TEXT UNIQUE,    -- Инвентарный номер (уникальный)
     room TEXT NOT NULL,              -- Кабинет/помещение
-    responsible TEXT NOT NULL        -- МОЛ (Материально ответственное лицо)
+    responsible TEXT NOT NULL,       -- МОЛ (Материально ответственное лицо)
+    classroom_id INTEGER REFERENCES Classrooms(id) ON DELETE SET NULL -- Кабинет из Classrooms
 );
 
 -- Создание таблицы Classrooms
@@ -44,4 +45,90 @@ INSERT INTO Classrooms (room_number, building, floor, purpose) VALUES
 ('24', 'A', 3, 'Английский язык'),
 ('25', 'A', 3, 'Биология'),
 ('26', 'A', 3, 'Информатика'),
-('27', 'A', 3, 'Бухгалтерия');
\ No newline at end of file
+('27', 'A', 3, 'Бухгалтерия');
+
+-- Вторичные индексы
+CREATE INDEX IF NOT EXISTS idx_equipment_room ON Equipment(room);
+CREATE INDEX IF NOT EXISTS idx_equipment_responsible
+    ON Equipment(responsible, name, quantity, inventory_number, room);
+CREATE INDEX IF NOT EXISTS idx_equipment_classroom
+    ON Equipment(classroom_id, name, quantity, inventory_number, room, responsible);
+CREATE INDEX IF NOT EXISTS idx_classrooms_location ON Classrooms(building, floor);
+CREATE INDEX IF NOT EXISTS idx_classrooms_purpose ON Classrooms(purpose);
+
+-- Поддержание связи Equipment.classroom_id -> Classrooms.id по номеру кабинета
+-- Строка изменяется, только если связь еще не задана запросом
+CREATE TRIGGER IF NOT EXISTS trg_equipment_link_insert AFTER INSERT ON Equipment
+WHEN NEW.classroom_id IS NOT (SELECT id FROM Classrooms WHERE room_number = NEW.room)
+BEGIN
+    UPDATE Equipment SET classroom_id = (SELECT id FROM Classrooms WHERE room_number = NEW.room)
+    WHERE id = NEW.id;
+END;
+
+CREATE TRIGGER IF NOT EXISTS trg_equipment_link_update AFTER UPDATE OF room ON Equipment
+WHEN NEW.classroom_id IS NOT (SELECT id FROM Classrooms WHERE room_number = NEW.room)
+BEGIN
+    UPDATE Equipment SET classroom_id = (SELECT id FROM Classrooms WHERE room_number = NEW.room)
+    WHERE id = NEW.id;
+END;
+
+CREATE TRIGGER IF NOT EXISTS trg_classrooms_link_insert AFTER INSERT ON Classrooms
+BEGIN
+    UPDATE Equipment SET classroom_id = NEW.id WHERE room = NEW.room_number;
+END;
+
+CREATE TRIGGER IF NOT EXISTS trg_classrooms_link_update AFTER UPDATE OF room_number ON Classrooms
+BEGIN
+    UPDATE Equipment SET classroom_id = NULL WHERE classroom_id = NEW.id;
+    UPDATE Equipment SET classroom_id = NEW.id WHERE room = NEW.room_number;
+END;
+
+-- История перемещений оборудования (только дополняется), ts - мс с начала эпохи Unix
+CREATE TABLE IF NOT EXISTS EquipmentHistory (
+    id INTEGER PRIMARY KEY AUTOINCREMENT,
+    inventory_number TEXT NOT NULL,  -- Инвентарный номер
+    ts INTEGER NOT NULL,             -- Время изменения, мс с начала эпохи Unix
+    op TEXT NOT NULL,                -- I - добавление, U - изменение, D - удаление
+    name TEXT NOT NULL,              -- Состояние записи после изменения
+    quantity INTEGER NOT NULL,       -- (для удаления - последнее состояние)
+    room TEXT NOT NULL,
+    responsible TEXT NOT NULL
+);
+CREATE INDEX IF NOT EXISTS idx_history_item_ts ON EquipmentHistory(inventory_number, ts);
+CREATE INDEX IF NOT EXISTS idx_history_deleted ON EquipmentHistory(inventory_number) WHERE op = 'D';
+
+CREATE TRIGGER IF NOT EXISTS trg_history_insert AFTER INSERT ON Equipment
+WHEN NEW.inventory_number IS NOT NULL
+BEGIN
+    INSERT INTO EquipmentHistory (inventory_number, ts, op, name, quantity, room, responsible)
+    VALUES (NEW.inventory_number, CAST((julianday('now') - 2440587.5) * 86400000 AS INTEGER),
+            'I', NEW.name, NEW.quantity, NEW.room, NEW.responsible);
+END;
+
+CREATE TRIGGER IF NOT EXISTS trg_history_update
+AFTER UPDATE OF name, quantity, inventory_number, room, responsible ON Equipment
+WHEN NEW.inventory_number IS NOT NULL AND (
+    OLD.name IS NOT NEW.name OR OLD.quantity IS NOT NEW.quantity OR
+    OLD.inventory_number IS NOT NEW.inventory_number OR
+    OLD.room IS NOT NEW.room OR OLD.responsible IS NOT NEW.responsible)
+BEGIN
+    INSERT INTO EquipmentHistory (inventory_number, ts, op, name, quantity, room, responsible)
+    SELECT OLD.inventory_number, CAST((julianday('now') - 2440587.5) * 86400000 AS INTEGER),
+           'D', OLD.name, OLD.quantity, OLD.room, OLD.responsible
+    WHERE OLD.inventory_number IS NOT NEW.inventory_number AND OLD.inventory_number IS NOT NULL;
+    INSERT INTO EquipmentHistory (inventory_number, ts, op, name, quantity, room, responsible)
+    VALUES (NEW.inventory_number, CAST((julianday('now') - 2440587.5) * 86400000 AS INTEGER),
+            CASE WHEN OLD.inventory_number IS NEW.inventory_number THEN 'U' ELSE 'I' END,
+            NEW.name, NEW.quantity, NEW.room, NEW.responsible);
+END;
+
+CREATE TRIGGER IF NOT EXISTS trg_history_delete AFTER DELETE ON Equipment
+WHEN OLD.inventory_number IS NOT NULL
+BEGIN
+    INSERT INTO EquipmentHistory (inventory_number, ts, op, name, quantity, room, responsible)
+    VALUES (OLD.inventory_number, CAST((julianday('now') - 2440587.5) * 86400000 AS INTEGER),
+            'D', OLD.name, OLD.quantity, OLD.room, OLD.responsible);
+END;
+
+-- Схема соответствует последней миграции Database::migrate()
+PRAGMA user_version = 2;
@@ -0,0 +1,144 @@
+#ifndef CHANGE_NOTIFIER_HPP
+#define CHANGE_NOTIFIER_HPP
+
+#include <sqlite3.h>          // Для sqlite3_int64
+#include <condition_variable> // Для очереди доставки
+#include <cstddef>            // Для std::size_t
+#include <deque>              // Для очереди пачек событий
+#include <functional>         // Для обработчиков подписчиков
+#include <map>                // Для объединения событий транзакции
+#include <memory>             // Для std::shared_ptr
+#include <mutex>              // Для многопоточной безопасности
+#include <string>             // Для работы со строками
+#include <thread>             // Для потока доставки
+#include <utility>            // Для std::pair
+#include <vector>             // Для пачек событий
+#include "../include/Logger.hpp" // Подключаем логгер
+
+/**
+ * @brief Изменение одной строки таблицы в зафиксированной транзакции.
+ */
+struct ChangeEvent {
+    // Вид изменения; несколько изменений строки в одной транзакции объединяются
+    enum Operation {
+        INSERTED,
+        UPDATED,
+        DELETED
+    };
+
+    Operation operation;
+    std::string table;          // Имя таблицы
+    sqlite3_int64 rowid;        // rowid измененной строки
+    std::string room;           // Кабинет после изменения (для удаления - до него)
+    std::string previous_room;  // Кабинет до изменения, если он поменялся
+};
+
+/**
+ * @brief Рассылка событий об изменениях подписчикам.
+ * 
+ * Изменения копятся, пока транзакция открыта, и передаются отдельному потоку
+ * доставки одной пачкой, только когда COMMIT завершился успешно; при откате
+ * отбрасываются. sqlite3_commit_hook вызывается до записи транзакции, и COMMIT
+ * еще может завершиться ошибкой, поэтому пачка публикуется в settle() после
+ * выполнения выражения. Методы record*, commit, rollback и settle вызываются
+ * в потоке соединения, подписка и доставка - из любых потоков.
+ * Очередь доставки ограничена kMaxQueuedBatches пачками: при отстающих
+ * подписчиках фиксирующий транзакцию поток ждет освобождения места.
+ * Откат к SAVEPOINT хуками не сообщается, поэтому внутри сохраненных точек
+ * отмененные изменения будут доставлены вместе с транзакцией.
+ */
+class ChangeNotifier {
+public:
+    using Callback = std::function<void(const std::vector<ChangeEvent>&)>;
+
+    // Предел пачек, ожидающих доставки
+    static constexpr std::size_t kMaxQueuedBatches = 1024;
+
+    explicit ChangeNotifier(Logger& logger);
+
+    /**
+     * @brief Деструктор: доставляет оставшиеся пачки и останавливает поток доставки.
+     */
+    ~ChangeNotifier();
+
+    ChangeNotifier(const ChangeNotifier&) = delete;
+    ChangeNotifier& operator=(const ChangeNotifier&) = delete;
+
+    /**
+     * @brief Регистрирует подписчика.
+     * 
+     * @param table Таблица, изменения которой нужны подписчику.
+     * @param room Кабинет для фильтрации (пустая строка - все кабинеты).
+     * @param callback Обработчик пачки событий; вызывается в потоке доставки.
+     * @return Идентификатор подписки.
+     */
+    int subscribe(const std::string& table, const std::string& room, Callback callback);
+
+    /**
+     * @brief Удаляет подписчика.
+     */
+    void unsubscribe(int id);
+
+    /**
+     * @brief Ждет, пока все зафиксированные пачки будут доставлены.
+     */
+    void waitIdle();
+
+    // Изменение строки (sqlite3_update_hook)
+    void recordChange(int operation, const char* table, sqlite3_int64 rowid);
+
+    // Кабинет до и после изменения строки (временные триггеры)
+    void recordRooms(const char* table, sqlite3_int64 rowid, const char* old_room, const char* new_room);
+
+    // Начало фиксации транзакции (sqlite3_commit_hook)
+    void commit();
+
+    // Откат транзакции (sqlite3_rollback_hook)
+    void rollback();
+
+    // Завершение выражения; autocommit - соединение вне транзакции (sqlite3_get_autocommit)
+    void settle(bool autocommit);
+
+private:
+    struct Subscription {
+        int id;
+        std::string table;
+        std::string room;
+        Callback callback;
+    };
+
+    // Объединенное изменение строки в открытой транзакции
+    struct PendingChange {
+        std::size_t order;                 // Порядок первого изменения строки
+        ChangeEvent::Operation first;      // Первое изменение в транзакции
+        ChangeEvent::Operation last;       // Последнее изменение в транзакции
+    };
+
+    using RowKey = std::pair<std::string, sqlite3_int64>;
+
+    void publish();
+    void discard();
+    void deliveryLoop();
+    static bool matches(const Subscription& subscription, const ChangeEvent& event);
+
+    Logger& logger;
+
+    // Состояние открытой транзакции (только поток соединения)
+    std::map<RowKey, PendingChange> pending;
+    std::map<RowKey, std::pair<std::string, std::string>> rooms; // Кабинет до и после по строкам
+    std::size_t pendingOrder = 0;
+    bool committing = false; // Хук фиксации вызван, результат COMMIT еще неизвестен
+
+    // Общие данные потока соединения, подписчиков и потока доставки
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::vector<std::shared_ptr<Subscription>> subscriptions;
+    std::deque<std::vector<ChangeEvent>> batches;
+    bool delivering = false;
+    bool stopping = false;
+    int nextId = 1;
+
+    std::thread worker;
+};
+
+#endif // CHANGE_NOTIFIER_HPP
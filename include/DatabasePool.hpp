@@ -0,0 +1,95 @@
+#ifndef DATABASE_POOL_HPP
+#define DATABASE_POOL_HPP
+
+#include <condition_variable> // Для ожидания свободного соединения
+#include <cstddef>            // Для std::size_t
+#include <memory>             // Для std::unique_ptr
+#include <mutex>              // Для многопоточной безопасности
+#include <string>             // Для работы со строками
+#include <vector>             // Для хранения соединений
+#include "../include/database.hpp" // Подключаем класс Database
+#include "../include/Logger.hpp"   // Подключаем логгер
+
+/**
+ * @brief Пул соединений Database с одним файлом БД.
+ * 
+ * Каждое соединение в любой момент используется одним потоком. БД переводится
+ * в режим WAL, чтобы читатели не блокировали писателя.
+ */
+class DatabasePool {
+public:
+    /**
+     * @brief Соединение, взятое из пула; возвращается в пул при уничтожении.
+     */
+    class Lease {
+    public:
+        Lease(DatabasePool& pool, Database* db) : pool(&pool), db(db) {}
+        Lease(Lease&& other) noexcept : pool(other.pool), db(other.db) { other.db = nullptr; }
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        Lease& operator=(Lease&&) = delete;
+        ~Lease() { if (db) pool->release(db); }
+
+        Database& operator*() const { return *db; }
+        Database* operator->() const { return db; }
+
+    private:
+        DatabasePool* pool;
+        Database* db;
+    };
+
+    /**
+     * @brief Конструктор класса.
+     * 
+     * Открывает size соединений и инициализирует структуру БД через первое из них.
+     * 
+     * @param db_path Путь к файлу базы данных (БД в памяти не разделяется между соединениями).
+     * @param size Число соединений.
+     * @param logger Ссылка на объект логгера.
+     * @throws std::runtime_error, если соединение не открылось или БД не инициализирована.
+     */
+    DatabasePool(const std::string& db_path, std::size_t size, Logger& logger);
+
+    /**
+     * @brief Берет свободное соединение, при необходимости ожидая его освобождения.
+     */
+    Lease acquire();
+
+    /**
+     * @brief Возвращает число соединений в пуле.
+     */
+    std::size_t size() const { return connections.size(); }
+
+    /**
+     * @brief Включает запись трассы вызовов всех соединений в один файл.
+     * 
+     * Вызывается до начала работы с соединениями. Как и Database::startRecording,
+     * перед записью снимает копию БД (trace::snapshotPath) для inventory_replay.
+     * 
+     * @param trace_path Путь к файлу трассы (перезаписывается вместе со снимком).
+     * @return true, если снимок снят и запись включена, иначе false.
+     */
+    bool startRecording(const std::string& trace_path);
+
+    /**
+     * @brief Включает журнал медленных запросов всех соединений в один файл.
+     * 
+     * Вызывается до начала работы с соединениями.
+     * 
+     * @param slow_log_path Путь к файлу журнала медленных запросов.
+     * @param threshold Порог длительности запроса.
+     * @return true, если профилирование включено на всех соединениях, иначе false.
+     */
+    bool enableProfiling(const std::string& slow_log_path, std::chrono::microseconds threshold);
+
+private:
+    // Возвращает соединение в пул
+    void release(Database* db);
+
+    std::vector<std::unique_ptr<Database>> connections; // Все соединения пула
+    std::vector<Database*> idle;                        // Свободные соединения
+    std::mutex poolMutex;                               // Защищает idle
+    std::condition_variable available;                  // Сигнал об освобождении соединения
+};
+
+#endif // DATABASE_POOL_HPP
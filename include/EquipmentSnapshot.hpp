@@ -0,0 +1,170 @@
+#ifndef EQUIPMENT_SNAPSHOT_HPP
+#define EQUIPMENT_SNAPSHOT_HPP
+
+#include <cstddef>       // Для std::size_t
+#include <cstdint>       // Для целочисленных типов фиксированного размера
+#include <limits>        // Для границ фильтра по количеству
+#include <mutex>         // Для накопления изменений из потока доставки
+#include <optional>      // Для необязательных условий фильтра
+#include <string>        // Для работы со строками
+#include <unordered_map> // Для словарей и позиций строк
+#include <unordered_set> // Для измененных строк
+#include <utility>       // Для std::pair
+#include <vector>        // Для столбцов
+#include "../include/database.hpp" // Подключаем класс Database
+
+/**
+ * @brief Столбцовый снимок Equipment вместе с Classrooms в памяти для аналитики.
+ * 
+ * Каждый столбец хранится отдельным непрерывным массивом: количество и этаж - целые числа,
+ * кабинет, МОЛ, корпус и назначение - коды словарей. Фильтры и агрегаты выполняются
+ * простыми циклами по массивам, которые компилятор векторизует.
+ * 
+ * Снимок подписывается на изменения Database и при refresh() перечитывает только
+ * измененные строки. Изменения видны только те, что сделаны через это соединение.
+ * Снимок используется в том же потоке, что и Database.
+ */
+class EquipmentSnapshot {
+public:
+    // Столбцы для группировки
+    enum Dimension {
+        ROOM,
+        RESPONSIBLE,
+        BUILDING,
+        PURPOSE
+    };
+
+    /**
+     * @brief Условие отбора; незаданные поля не проверяются.
+     * 
+     * Оборудование кабинета, которого нет в Classrooms, имеет пустые корпус и назначение
+     * и не отбирается условием по этажу.
+     */
+    struct Filter {
+        std::optional<std::string> room;
+        std::optional<std::string> responsible;
+        std::optional<std::string> building;
+        std::optional<std::string> purpose;
+        std::optional<int> floor;
+        int min_quantity = std::numeric_limits<int>::min(); // Количество не меньше
+        int max_quantity = std::numeric_limits<int>::max(); // Количество не больше
+    };
+
+    /**
+     * @brief Число записей и суммарное количество.
+     */
+    struct Totals {
+        std::size_t items = 0;
+        std::int64_t quantity = 0;
+    };
+
+    /**
+     * @brief Конструктор класса: подписывается на изменения Equipment и Classrooms.
+     * 
+     * @param db База данных после initialize(); должна жить дольше снимка.
+     */
+    explicit EquipmentSnapshot(Database& db);
+
+    /**
+     * @brief Деструктор: отменяет подписки.
+     */
+    ~EquipmentSnapshot();
+
+    EquipmentSnapshot(const EquipmentSnapshot&) = delete;
+    EquipmentSnapshot& operator=(const EquipmentSnapshot&) = delete;
+
+    /**
+     * @brief Полностью загружает снимок из БД.
+     * 
+     * @return true, если снимок загружен, иначе false.
+     */
+    bool load();
+
+    /**
+     * @brief Применяет изменения, зафиксированные после предыдущей загрузки.
+     * 
+     * Перечитываются только измененные строки Equipment и строки кабинетов, измененных
+     * в Classrooms (по индексу Equipment(classroom_id)). Если подписаться на изменения
+     * не удалось, снимок загружается заново.
+     * 
+     * @return true, если снимок обновлен, иначе false.
+     */
+    bool refresh();
+
+    /**
+     * @brief Возвращает число записей в снимке.
+     */
+    std::size_t size() const { return ids.size(); }
+
+    /**
+     * @brief Считает записи, удовлетворяющие условию, и их суммарное количество.
+     */
+    Totals totals(const Filter& filter) const;
+
+    /**
+     * @brief Группирует записи, удовлетворяющие условию, по значению столбца.
+     * 
+     * @return Пары (значение, итоги) для непустых групп в порядке появления значений.
+     */
+    std::vector<std::pair<std::string, Totals>> totalsBy(Dimension dimension, const Filter& filter) const;
+
+    /**
+     * @brief Возвращает инвентарные номера записей, удовлетворяющих условию.
+     */
+    std::vector<std::string> inventoryNumbers(const Filter& filter) const;
+
+private:
+    using Code = std::uint32_t;
+
+    // Этаж строки без кабинета в Classrooms или с неизвестным этажом; условию по этажу не отвечает
+    static constexpr std::int32_t kNoFloor = std::numeric_limits<std::int32_t>::min();
+
+    // Словарь строковых значений; код 0 - пустая строка (NULL)
+    class Dictionary {
+    public:
+        Dictionary() { clear(); }
+        Code encode(const std::string& value);
+        std::optional<Code> find(const std::string& value) const;
+        const std::string& decode(Code code) const { return values[code]; }
+        std::size_t size() const { return values.size(); }
+        void clear();
+
+    private:
+        std::vector<std::string> values;
+        std::unordered_map<std::string, Code> codes;
+    };
+
+    // Строит маску отобранных строк; false - ни одна строка не подходит
+    bool select(const Filter& filter, std::vector<std::uint8_t>& mask) const;
+
+    void upsert(const EquipmentLocationRecord& record);
+    void erase(std::int64_t id);
+    void clear();
+
+    Database& db;
+    int equipmentSubscription;
+    int classroomsSubscription;
+
+    // Изменения, полученные из потока доставки
+    std::mutex changesMutex;
+    std::unordered_set<std::int64_t> changedEquipment;
+    std::unordered_set<std::int64_t> changedClassrooms;
+
+    // Столбцы снимка
+    std::vector<std::int64_t> ids;
+    std::vector<std::string> inventory_numbers;
+    std::vector<std::int32_t> quantities;
+    std::vector<std::int32_t> floors;        // kNoFloor - этаж неизвестен
+    std::vector<Code> rooms;
+    std::vector<Code> responsibles;
+    std::vector<Code> buildings;
+    std::vector<Code> purposes;
+
+    std::unordered_map<std::int64_t, std::size_t> positions; // id -> номер строки
+    Dictionary roomDictionary;
+    Dictionary responsibleDictionary;
+    Dictionary buildingDictionary;
+    Dictionary purposeDictionary;
+};
+
+#endif // EQUIPMENT_SNAPSHOT_HPP
@@ -0,0 +1,255 @@
+#ifndef INVENTORY_SCHEMA_HPP
+#define INVENTORY_SCHEMA_HPP
+
+#include <cstdint>  // Для целочисленных типов фиксированного размера
+#include <optional> // Для столбцов, допускающих NULL
+#include <string>   // Для работы со строками
+#include <tuple>    // Для списков столбцов
+#include "../include/Schema.hpp" // Подключаем описание схемы на этапе компиляции
+
+/**
+ * @brief Запись таблицы Equipment.
+ */
+struct EquipmentRecord {
+    std::int64_t id = 0;                     // Первичный ключ
+    std::string name;                        // Наименование оборудования
+    int quantity = 0;                        // Количество
+    std::string inventory_number;            // Инвентарный номер (уникальный)
+    std::string room;                        // Кабинет/помещение
+    std::string responsible;                 // МОЛ (Материально ответственное лицо)
+    std::optional<std::int64_t> classroom_id; // Кабинет из Classrooms, если номер кабинета известен
+};
+
+/**
+ * @brief Запись таблицы Classrooms.
+ */
+struct ClassroomRecord {
+    std::int64_t id = 0;                    // Первичный ключ
+    std::string room_number;                // Номер кабинета (уникальный)
+    std::string building;                   // Корпус (А, Б1, Б2)
+    int floor = 0;                          // Этаж
+    std::optional<std::string> purpose;     // Назначение (история, математика и т.д.)
+    std::optional<std::string> responsible; // Ответственный за кабинет
+};
+
+/**
+ * @brief Оборудование вместе с данными кабинета (Equipment LEFT JOIN Classrooms).
+ */
+struct EquipmentLocationRecord {
+    std::int64_t id = 0;                      // Первичный ключ Equipment
+    std::string inventory_number;             // Инвентарный номер
+    int quantity = 0;                         // Количество
+    std::string room;                         // Кабинет/помещение
+    std::string responsible;                  // МОЛ
+    std::optional<std::int64_t> classroom_id; // Кабинет из Classrooms
+    std::optional<std::string> building;      // Корпус (нет, если кабинета нет в Classrooms)
+    std::optional<int> floor;                 // Этаж
+    std::optional<std::string> purpose;       // Назначение кабинета
+};
+
+// Столбцы таблицы Equipment
+namespace equipment {
+
+struct Id : schema::Column<EquipmentRecord, std::int64_t, &EquipmentRecord::id> {
+    static constexpr std::string_view name = "id";
+    static constexpr std::string_view definition = "INTEGER PRIMARY KEY AUTOINCREMENT";
+};
+
+struct Name : schema::Column<EquipmentRecord, std::string, &EquipmentRecord::name> {
+    static constexpr std::string_view name = "name";
+    static constexpr std::string_view definition = "TEXT NOT NULL";
+};
+
+struct Quantity : schema::Column<EquipmentRecord, int, &EquipmentRecord::quantity> {
+    static constexpr std::string_view name = "quantity";
+    static constexpr std::string_view definition = "INTEGER NOT NULL";
+};
+
+struct InventoryNumber : schema::Column<EquipmentRecord, std::string, &EquipmentRecord::inventory_number> {
+    static constexpr std::string_view name = "inventory_number";
+    static constexpr std::string_view definition = "TEXT UNIQUE";
+};
+
+struct Room : schema::Column<EquipmentRecord, std::string, &EquipmentRecord::room> {
+    static constexpr std::string_view name = "room";
+    static constexpr std::string_view definition = "TEXT NOT NULL";
+};
+
+struct Responsible : schema::Column<EquipmentRecord, std::string, &EquipmentRecord::responsible> {
+    static constexpr std::string_view name = "responsible";
+    static constexpr std::string_view definition = "TEXT NOT NULL";
+};
+
+struct ClassroomId : schema::Column<EquipmentRecord, std::optional<std::int64_t>, &EquipmentRecord::classroom_id> {
+    static constexpr std::string_view name = "classroom_id";
+    static constexpr std::string_view definition = "INTEGER REFERENCES Classrooms(id) ON DELETE SET NULL";
+};
+
+} // namespace equipment
+
+// Столбцы таблицы Classrooms
+namespace classrooms {
+
+struct Id : schema::Column<ClassroomRecord, std::int64_t, &ClassroomRecord::id> {
+    static constexpr std::string_view name = "id";
+    static constexpr std::string_view definition = "INTEGER PRIMARY KEY AUTOINCREMENT";
+};
+
+struct RoomNumber : schema::Column<ClassroomRecord, std::string, &ClassroomRecord::room_number> {
+    static constexpr std::string_view name = "room_number";
+    static constexpr std::string_view definition = "TEXT NOT NULL UNIQUE";
+};
+
+struct Building : schema::Column<ClassroomRecord, std::string, &ClassroomRecord::building> {
+    static constexpr std::string_view name = "building";
+    static constexpr std::string_view definition = "TEXT NOT NULL";
+};
+
+struct Floor : schema::Column<ClassroomRecord, int, &ClassroomRecord::floor> {
+    static constexpr std::string_view name = "floor";
+    static constexpr std::string_view definition = "INTEGER NOT NULL";
+};
+
+struct Purpose : schema::Column<ClassroomRecord, std::optional<std::string>, &ClassroomRecord::purpose> {
+    static constexpr std::string_view name = "purpose";
+    static constexpr std::string_view definition = "TEXT";
+};
+
+struct Responsible : schema::Column<ClassroomRecord, std::optional<std::string>, &ClassroomRecord::responsible> {
+    static constexpr std::string_view name = "responsible";
+    static constexpr std::string_view definition = "TEXT";
+};
+
+} // namespace classrooms
+
+/**
+ * @brief Описание таблицы Equipment.
+ */
+struct EquipmentTable {
+    using record_type = EquipmentRecord;
+    static constexpr std::string_view name = "Equipment";
+    using columns = std::tuple<equipment::Id, equipment::Name, equipment::Quantity, equipment::InventoryNumber,
+                               equipment::Room, equipment::Responsible, equipment::ClassroomId>;
+};
+
+/**
+ * @brief Описание таблицы Classrooms.
+ */
+struct ClassroomsTable {
+    using record_type = ClassroomRecord;
+    static constexpr std::string_view name = "Classrooms";
+    using columns = std::tuple<classrooms::Id, classrooms::RoomNumber, classrooms::Building, classrooms::Floor,
+                               classrooms::Purpose, classrooms::Responsible>;
+};
+
+// Запросы к Equipment, построенные на этапе компиляции
+namespace equipment {
+
+// Поля, которые задает пользователь, в порядке столбцов результата поиска
+using Fields = std::tuple<Name, Quantity, InventoryNumber, Room, Responsible>;
+
+// Источник строк: оборудование кабинетов (Classrooms AS c JOIN Equipment AS e)
+struct FromClassrooms {
+    using table = EquipmentTable;
+    static constexpr std::string_view prefix = "e.";
+
+    template <typename Writer>
+    static constexpr void write(Writer& writer) {
+        writer.append(" FROM Classrooms AS c JOIN Equipment AS e ON e.classroom_id = c.id");
+    }
+};
+
+// Условие: корпус и этаж кабинета
+struct WhereLocation {
+    using parameters = std::tuple<classrooms::Building, classrooms::Floor>;
+
+    template <typename Writer>
+    static constexpr void write(Writer& writer, std::string_view) {
+        writer.append(" WHERE c.building = ? AND c.floor = ?");
+    }
+};
+
+// Условие: назначение кабинета
+struct WherePurpose {
+    using parameters = std::tuple<schema::Parameter<std::string>>;
+
+    template <typename Writer>
+    static constexpr void write(Writer& writer, std::string_view) {
+        writer.append(" WHERE c.purpose = ?");
+    }
+};
+
+// Поиск classroom_id по номеру кабинета из параметра запроса с номером index.
+// Связь задается в самом INSERT/UPDATE, поэтому триггеру не нужно второй раз изменять строку.
+template <typename Writer>
+constexpr void writeClassroomLookup(Writer& writer, std::string_view index) {
+    writer.append("(SELECT id FROM Classrooms WHERE room_number = ?");
+    writer.append(index);
+    writer.append(")");
+}
+
+// INSERT полей пользователя и classroom_id по номеру кабинета (Room - 4-й параметр)
+struct InsertLinked {
+    using parameters = Fields;
+    using result = std::tuple<>;
+
+    template <typename Writer>
+    static constexpr void write(Writer& writer) {
+        writer.append("INSERT INTO ");
+        writer.append(EquipmentTable::name);
+        writer.append(" (");
+        schema::writeColumns(writer, schema::columns<Fields>(), "", "", ", ");
+        writer.append(", ");
+        writer.append(ClassroomId::name);
+        writer.append(") VALUES (");
+        schema::writePlaceholders(writer, std::tuple_size<Fields>::value);
+        writer.append(", ");
+        writeClassroomLookup(writer, "4");
+        writer.append(");");
+    }
+};
+
+// UPDATE количества, кабинета и МОЛ вместе с classroom_id (Room - 2-й параметр)
+struct UpdateLinked {
+    using changed = std::tuple<Quantity, Room, Responsible>;
+    using parameters = std::tuple<Quantity, Room, Responsible, InventoryNumber>;
+    using result = std::tuple<>;
+
+    template <typename Writer>
+    static constexpr void write(Writer& writer) {
+        writer.append("UPDATE ");
+        writer.append(EquipmentTable::name);
+        writer.append(" SET ");
+        schema::writeColumns(writer, schema::columns<changed>(), "", " = ?", ", ");
+        writer.append(", ");
+        writer.append(ClassroomId::name);
+        writer.append(" = ");
+        writeClassroomLookup(writer, "2");
+        writer.append(" WHERE ");
+        writer.append(InventoryNumber::name);
+        writer.append(" = ?;");
+    }
+};
+
+using CreateTable = schema::Sql<schema::CreateTable<EquipmentTable>>;
+using Insert = schema::Sql<InsertLinked>;
+using Update = schema::Sql<UpdateLinked>;
+using Delete = schema::Sql<schema::Delete<EquipmentTable, InventoryNumber>>;
+using Search = schema::Sql<schema::Select<Fields, schema::WhereLike<Name, Room>, schema::From<EquipmentTable>>>;
+using SelectByInventory =
+    schema::Sql<schema::Select<Fields, schema::WhereEquals<InventoryNumber>, schema::From<EquipmentTable>>>;
+using SelectByResponsible =
+    schema::Sql<schema::Select<Fields, schema::WhereEquals<Responsible>, schema::From<EquipmentTable>>>;
+using SelectByLocation = schema::Sql<schema::Select<Fields, WhereLocation, FromClassrooms>>;
+using SelectByPurpose = schema::Sql<schema::Select<Fields, WherePurpose, FromClassrooms>>;
+
+} // namespace equipment
+
+// Запросы к Classrooms, построенные на этапе компиляции
+namespace classrooms {
+
+using CreateTable = schema::Sql<schema::CreateTable<ClassroomsTable>>;
+
+} // namespace classrooms
+
+#endif // INVENTORY_SCHEMA_HPP
@@ -0,0 +1,44 @@
+#ifndef LATENCY_STATS_HPP
+#define LATENCY_STATS_HPP
+
+#include <algorithm> // Для std::sort
+#include <cstddef>   // Для std::size_t
+#include <vector>    // Для выборки задержек
+
+/**
+ * @brief Сводка по выборке задержек (в микросекундах).
+ */
+struct LatencySummary {
+    std::size_t count = 0; // Число замеров
+    double p50 = 0;        // Медиана
+    double p95 = 0;        // 95-й процентиль
+    double p99 = 0;        // 99-й процентиль
+    double max = 0;        // Максимум
+};
+
+/**
+ * @brief Считает процентили выборки задержек.
+ * 
+ * @param samples Задержки в микросекундах; вектор сортируется на месте.
+ * @return Сводка по выборке; для пустой выборки все значения нулевые.
+ */
+inline LatencySummary summarizeLatencies(std::vector<double>& samples) {
+    LatencySummary summary;
+    if (samples.empty()) {
+        return summary;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    auto at = [&](double q) {
+        return samples[static_cast<std::size_t>(q * static_cast<double>(samples.size() - 1))];
+    };
+
+    summary.count = samples.size();
+    summary.p50 = at(0.50);
+    summary.p95 = at(0.95);
+    summary.p99 = at(0.99);
+    summary.max = samples.back();
+    return summary;
+}
+
+#endif // LATENCY_STATS_HPP
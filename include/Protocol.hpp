@@ -0,0 +1,118 @@
+#ifndef PROTOCOL_HPP
+#define PROTOCOL_HPP
+
+#include <cstddef> // Для std::size_t
+#include <cstdint> // Для целочисленных типов фиксированного размера
+#include <string>  // Для работы со строками
+#include <vector>  // Для аргументов и строк результата
+
+/**
+ * @brief Сетевой протокол сервера учета оборудования.
+ * 
+ * Каждое сообщение передается кадром: 4 байта длины (big-endian) и тело.
+ * Запрос: 1 байт операции, число аргументов (u32) и аргументы.
+ * Ответ: 1 байт статуса, число строк (u32), для каждой строки число столбцов (u32) и значения.
+ * Строки кодируются как длина (u32) и байты. При ошибке ответ содержит одну строку с текстом ошибки.
+ */
+namespace protocol {
+
+// Операции запроса
+enum class Op : std::uint8_t {
+    Search = 1, // searchEquipment(query)
+    Get = 2,    // getEquipment(inventory_number)
+    Add = 3,    // addEquipment(name, quantity, inventory_number, room, responsible)
+    Update = 4, // updateEquipment(inventory_number, quantity, room, responsible)
+    Remove = 5  // removeEquipment(inventory_number)
+};
+
+// Статус ответа
+enum class Status : std::uint8_t {
+    Ok = 0,
+    Error = 1
+};
+
+// Запрос клиента
+struct Request {
+    Op op;
+    std::vector<std::string> args;
+};
+
+// Ответ сервера
+struct Response {
+    Status status;
+    std::vector<std::vector<std::string>> rows;
+};
+
+// Максимальный размер тела кадра
+constexpr std::size_t kMaxFrameSize = 16 * 1024 * 1024;
+
+/**
+ * @brief Кодирует тело запроса.
+ */
+std::string encodeRequest(const Request& request);
+
+/**
+ * @brief Декодирует тело запроса.
+ * 
+ * @return true, если тело корректно, иначе false.
+ */
+bool decodeRequest(const std::string& payload, Request& request);
+
+/**
+ * @brief Кодирует тело ответа.
+ */
+std::string encodeResponse(const Response& response);
+
+/**
+ * @brief Декодирует тело ответа.
+ * 
+ * @return true, если тело корректно, иначе false.
+ */
+bool decodeResponse(const std::string& payload, Response& response);
+
+/**
+ * @brief Добавляет к телу заголовок длины.
+ */
+std::string frame(const std::string& payload);
+
+/**
+ * @brief Извлекает из буфера первый полный кадр.
+ * 
+ * @param buffer Накопленные байты; извлеченный кадр удаляется из начала буфера.
+ * @param payload Тело извлеченного кадра.
+ * @return 1 - кадр извлечен, 0 - данных пока недостаточно, -1 - длина кадра превышает kMaxFrameSize.
+ */
+int takeFrame(std::string& buffer, std::string& payload);
+
+/**
+ * @brief Проверяет, задан ли адрес номером TCP-порта (только цифры), а не путем к Unix-сокету.
+ */
+bool isPortAddress(const std::string& address);
+
+/**
+ * @brief Разбирает номер TCP-порта.
+ * 
+ * @param address Адрес из одних цифр.
+ * @param port Номер порта.
+ * @return true, если число помещается в диапазон 0..65535, иначе false.
+ */
+bool parsePort(const std::string& address, std::uint16_t& port);
+
+/**
+ * @brief Подключается к серверу.
+ * 
+ * @param address Номер TCP-порта на 127.0.0.1 (1..65535) или путь к Unix-сокету.
+ * @return Дескриптор сокета или -1 при ошибке.
+ */
+int connectTo(const std::string& address);
+
+/**
+ * @brief Отправляет запрос и ждет ответа (блокирующий вызов).
+ * 
+ * @return true, если ответ получен и декодирован, иначе false.
+ */
+bool call(int fd, const Request& request, Response& response);
+
+} // namespace protocol
+
+#endif // PROTOCOL_HPP
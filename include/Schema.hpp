@@ -0,0 +1,385 @@
+#ifndef SCHEMA_HPP
+#define SCHEMA_HPP
+
+#include <sqlite3.h>   // Библиотека SQLite3
+#include <cstddef>     // Для std::size_t
+#include <cstdint>     // Для целочисленных типов фиксированного размера
+#include <optional>    // Для столбцов, допускающих NULL
+#include <string>      // Для работы со строками
+#include <string_view> // Для имен таблиц и столбцов
+#include <tuple>       // Для списков столбцов
+#include <type_traits> // Для проверок типов
+
+/**
+ * @brief Описание таблиц на этапе компиляции.
+ *
+ * Таблица - это тип с именем и списком столбцов; столбец - тип с именем,
+ * SQL-определением и указателем на поле записи. Из описания на этапе компиляции
+ * строятся тексты CREATE TABLE, INSERT, UPDATE, DELETE и SELECT (schema::Sql),
+ * а также типизированная привязка параметров (schema::bind) и чтение строк
+ * результата (schema::extract). Несоответствие числа или типов параметров,
+ * столбцы чужой таблицы и неподдерживаемые типы полей дают ошибку компиляции.
+ */
+namespace schema {
+
+/**
+ * @brief Базовый тип столбца.
+ *
+ * Наследник задает static constexpr std::string_view name и definition.
+ */
+template <typename Record, typename T, T Record::*Member>
+struct Column {
+    using record_type = Record;
+    using value_type = T;
+    static constexpr T Record::*member = Member;
+};
+
+/**
+ * @brief Параметр, не связанный со столбцом (например, шаблон LIKE).
+ */
+template <typename T>
+struct Parameter {
+    using value_type = T;
+};
+
+// Строка фиксированной длины, построенная на этапе компиляции
+template <std::size_t N>
+struct FixedString {
+    char data[N + 1]{};
+};
+
+// Подсчет длины генерируемого текста
+struct LengthCounter {
+    std::size_t size = 0;
+    constexpr void append(std::string_view text) { size += text.size(); }
+};
+
+// Запись генерируемого текста в FixedString
+template <std::size_t N>
+struct TextWriter {
+    FixedString<N> result{};
+    std::size_t pos = 0;
+    constexpr void append(std::string_view text) {
+        for (char c : text) {
+            result.data[pos++] = c;
+        }
+    }
+};
+
+/**
+ * @brief Текст SQL, построенный генератором на этапе компиляции.
+ *
+ * Генератор задает template <typename Writer> static constexpr void write(Writer&),
+ * а также типы parameters (столбцы параметров) и, для SELECT, result (столбцы результата).
+ */
+template <typename Generator>
+struct Sql {
+    using parameters = typename Generator::parameters;
+    using result = typename Generator::result;
+
+    static constexpr std::size_t size = [] {
+        LengthCounter counter;
+        Generator::write(counter);
+        return counter.size;
+    }();
+
+    static constexpr FixedString<size> buffer = [] {
+        TextWriter<size> writer;
+        Generator::write(writer);
+        return writer.result;
+    }();
+
+    static constexpr std::string_view text{buffer.data, size};
+    static constexpr const char* c_str = buffer.data;
+};
+
+// Записывает список столбцов через separator: prefix + name + suffix
+template <typename... Cols, typename Writer>
+constexpr void writeColumns(Writer& writer, std::tuple<Cols...>*, std::string_view prefix,
+                            std::string_view suffix, std::string_view separator) {
+    bool first = true;
+    ((writer.append(first ? std::string_view() : separator), first = false,
+      writer.append(prefix), writer.append(Cols::name), writer.append(suffix)), ...);
+}
+
+// Записывает count параметров "?, ?, ..."
+template <typename Writer>
+constexpr void writePlaceholders(Writer& writer, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        writer.append(i == 0 ? "?" : ", ?");
+    }
+}
+
+// Проверяет, что все столбцы принадлежат таблице
+template <typename Table, typename... Cols>
+constexpr bool belongsTo(std::tuple<Cols...>*) {
+    return (std::is_same<typename Cols::record_type, typename Table::record_type>::value && ...);
+}
+
+// Указатель-метка для передачи списка столбцов в функции
+template <typename Columns>
+constexpr Columns* columns() {
+    return nullptr;
+}
+
+/**
+ * @brief CREATE TABLE по описанию таблицы.
+ */
+template <typename Table>
+struct CreateTable {
+    using parameters = std::tuple<>;
+    using result = std::tuple<>;
+
+    template <typename Writer>
+    static constexpr void write(Writer& writer) {
+        writer.append("CREATE TABLE ");
+        writer.append(Table::name);
+        writer.append(" (");
+        writeDefinitions(writer, columns<typename Table::columns>());
+        writer.append(");");
+    }
+
+private:
+    template <typename... Cols, typename Writer>
+    static constexpr void writeDefinitions(Writer& writer, std::tuple<Cols...>*) {
+        bool first = true;
+        ((writer.append(first ? "" : ", "), first = false,
+          writer.append(Cols::name), writer.append(" "), writer.append(Cols::definition)), ...);
+    }
+};
+
+/**
+ * @brief INSERT INTO Table (Cols...) VALUES (?, ...).
+ */
+template <typename Table, typename Columns>
+struct Insert {
+    static_assert(belongsTo<Table>(columns<Columns>()), "Столбец не принадлежит таблице");
+
+    using parameters = Columns;
+    using result = std::tuple<>;
+
+    template <typename Writer>
+    static constexpr void write(Writer& writer) {
+        writer.append("INSERT INTO ");
+        writer.append(Table::name);
+        writer.append(" (");
+        writeColumns(writer, columns<Columns>(), "", "", ", ");
+        writer.append(") VALUES (");
+        writePlaceholders(writer, std::tuple_size<Columns>::value);
+        writer.append(");");
+    }
+};
+
+/**
+ * @brief UPDATE Table SET col = ?, ... WHERE Key = ?.
+ */
+template <typename Table, typename Columns, typename Key>
+struct Update {
+    static_assert(belongsTo<Table>(columns<Columns>()) && belongsTo<Table>(columns<std::tuple<Key>>()),
+                  "Столбец не принадлежит таблице");
+
+    using parameters = decltype(std::tuple_cat(std::declval<Columns>(), std::declval<std::tuple<Key>>()));
+    using result = std::tuple<>;
+
+    template <typename Writer>
+    static constexpr void write(Writer& writer) {
+        writer.append("UPDATE ");
+        writer.append(Table::name);
+        writer.append(" SET ");
+        writeColumns(writer, columns<Columns>(), "", " = ?", ", ");
+        writer.append(" WHERE ");
+        writer.append(Key::name);
+        writer.append(" = ?;");
+    }
+};
+
+/**
+ * @brief DELETE FROM Table WHERE Key = ?.
+ */
+template <typename Table, typename Key>
+struct Delete {
+    static_assert(belongsTo<Table>(columns<std::tuple<Key>>()), "Столбец не принадлежит таблице");
+
+    using parameters = std::tuple<Key>;
+    using result = std::tuple<>;
+
+    template <typename Writer>
+    static constexpr void write(Writer& writer) {
+        writer.append("DELETE FROM ");
+        writer.append(Table::name);
+        writer.append(" WHERE ");
+        writer.append(Key::name);
+        writer.append(" = ?;");
+    }
+};
+
+/**
+ * @brief Источник строк SELECT: одна таблица без псевдонима.
+ */
+template <typename Table>
+struct From {
+    using table = Table;
+    static constexpr std::string_view prefix = "";
+
+    template <typename Writer>
+    static constexpr void write(Writer& writer) {
+        writer.append(" FROM ");
+        writer.append(Table::name);
+    }
+};
+
+/**
+ * @brief Условие WHERE Col = ?.
+ */
+template <typename Col>
+struct WhereEquals {
+    using parameters = std::tuple<Col>;
+
+    template <typename Writer>
+    static constexpr void write(Writer& writer, std::string_view prefix) {
+        writer.append(" WHERE ");
+        writer.append(prefix);
+        writer.append(Col::name);
+        writer.append(" = ?");
+    }
+};
+
+/**
+ * @brief Условие WHERE a LIKE ?1 OR b LIKE ?1 с одним параметром-шаблоном.
+ */
+template <typename... Cols>
+struct WhereLike {
+    using parameters = std::tuple<Parameter<std::string>>;
+
+    template <typename Writer>
+    static constexpr void write(Writer& writer, std::string_view prefix) {
+        writer.append(" WHERE ");
+        writeColumns(writer, columns<std::tuple<Cols...>>(), prefix, " LIKE ?1", " OR ");
+    }
+};
+
+/**
+ * @brief SELECT Cols... FROM Source Where.
+ */
+template <typename Columns, typename Where, typename Source>
+struct Select {
+    static_assert(belongsTo<typename Source::table>(columns<Columns>()), "Столбец не принадлежит таблице");
+
+    using parameters = typename Where::parameters;
+    using result = Columns;
+
+    template <typename Writer>
+    static constexpr void write(Writer& writer) {
+        writer.append("SELECT ");
+        writeColumns(writer, columns<Columns>(), Source::prefix, "", ", ");
+        Source::write(writer);
+        Where::write(writer, Source::prefix);
+        writer.append(";");
+    }
+};
+
+/**
+ * @brief Привязка значения к параметру и чтение значения столбца для поддерживаемых типов.
+ */
+template <typename T>
+struct Binder {
+    static_assert(sizeof(T) == 0, "Тип столбца не поддерживается schema::Binder");
+};
+
+template <>
+struct Binder<int> {
+    static int bind(sqlite3_stmt* stmt, int index, int value) { return sqlite3_bind_int(stmt, index, value); }
+    static int extract(sqlite3_stmt* stmt, int index) { return sqlite3_column_int(stmt, index); }
+};
+
+template <>
+struct Binder<std::int64_t> {
+    static int bind(sqlite3_stmt* stmt, int index, std::int64_t value) { return sqlite3_bind_int64(stmt, index, value); }
+    static std::int64_t extract(sqlite3_stmt* stmt, int index) { return sqlite3_column_int64(stmt, index); }
+};
+
+template <>
+struct Binder<std::string> {
+    // Строка должна жить до сброса выражения (SQLITE_STATIC)
+    static int bind(sqlite3_stmt* stmt, int index, const std::string& value) {
+        return sqlite3_bind_text(stmt, index, value.data(), static_cast<int>(value.size()), SQLITE_STATIC);
+    }
+    static std::string extract(sqlite3_stmt* stmt, int index) {
+        const char* text = reinterpret_cast<const char*>(sqlite3_column_text(stmt, index));
+        return text ? std::string(text, static_cast<std::size_t>(sqlite3_column_bytes(stmt, index))) : std::string();
+    }
+};
+
+template <typename T>
+struct Binder<std::optional<T>> {
+    static int bind(sqlite3_stmt* stmt, int index, const std::optional<T>& value) {
+        return value ? Binder<T>::bind(stmt, index, *value) : sqlite3_bind_null(stmt, index);
+    }
+    static std::optional<T> extract(sqlite3_stmt* stmt, int index) {
+        if (sqlite3_column_type(stmt, index) == SQLITE_NULL) {
+            return std::nullopt;
+        }
+        return Binder<T>::extract(stmt, index);
+    }
+};
+
+// Привязка параметров по списку столбцов; типы аргументов совпадают с типами полей
+template <typename Columns>
+struct Params;
+
+template <typename... Cols>
+struct Params<std::tuple<Cols...>> {
+    // Аргументы должны иметь ровно тип поля: неявное преобразование (const char*, double
+    // в std::string) создало бы временную строку, привязанную без копирования
+    template <typename... Args>
+    static constexpr bool exact = (std::is_same<std::decay_t<Args>, typename Cols::value_type>::value && ...);
+
+    static bool bind(sqlite3_stmt* stmt, const typename Cols::value_type&... values) {
+        int index = 0;
+        bool ok = true;
+        ((ok = ok && Binder<typename Cols::value_type>::bind(stmt, ++index, values) == SQLITE_OK), ...);
+        return ok;
+    }
+};
+
+/**
+ * @brief Привязывает параметры запроса Query.
+ *
+ * Строки привязываются без копирования (SQLITE_STATIC), поэтому аргументы должны иметь
+ * ровно тип поля и быть lvalue, которые живут до сброса выражения.
+ *
+ * @return true, если все параметры привязаны, иначе false.
+ */
+template <typename Query, typename... Args>
+bool bind(sqlite3_stmt* stmt, Args&&... values) {
+    using Parameters = Params<typename Query::parameters>;
+    static_assert(sizeof...(Args) == std::tuple_size<typename Query::parameters>::value,
+                  "Число аргументов не совпадает с числом параметров запроса");
+    static_assert(Parameters::template exact<Args...>, "Тип аргумента не совпадает с типом поля");
+    static_assert(((std::is_lvalue_reference<Args>::value || std::is_arithmetic<std::decay_t<Args>>::value) && ...),
+                  "Временное значение нельзя привязать без копирования");
+    return Parameters::bind(stmt, values...);
+}
+
+// Чтение строки результата в запись
+template <typename Record, typename... Cols>
+Record extractColumns(sqlite3_stmt* stmt, std::tuple<Cols...>*) {
+    static_assert((std::is_same<typename Cols::record_type, Record>::value && ...),
+                  "Столбец результата не принадлежит записи");
+    Record record{};
+    int index = 0;
+    ((record.*Cols::member = Binder<typename Cols::value_type>::extract(stmt, index++)), ...);
+    return record;
+}
+
+/**
+ * @brief Читает текущую строку результата запроса Query в запись Record.
+ */
+template <typename Query, typename Record>
+Record extract(sqlite3_stmt* stmt) {
+    return extractColumns<Record>(stmt, columns<typename Query::result>());
+}
+
+} // namespace schema
+
+#endif // SCHEMA_HPP
@@ -0,0 +1,141 @@
+#ifndef SERVER_HPP
+#define SERVER_HPP
+
+#include <atomic>             // Для флага остановки
+#include <condition_variable> // Для очереди заданий
+#include <cstddef>            // Для std::size_t
+#include <cstdint>            // Для целочисленных типов фиксированного размера
+#include <deque>              // Для очередей запросов
+#include <mutex>              // Для многопоточной безопасности
+#include <string>             // Для работы со строками
+#include <thread>             // Для рабочих потоков
+#include <unordered_map>      // Для таблицы соединений
+#include <vector>             // Для списков потоков и ответов
+#include "../include/DatabasePool.hpp" // Подключаем пул соединений с БД
+#include "../include/Logger.hpp"       // Подключаем логгер
+
+/**
+ * @brief Локальный многоклиентский сервер учета оборудования.
+ * 
+ * Сетевой ввод-вывод ведет один поток с циклом epoll, запросы выполняются
+ * пулом рабочих потоков на соединениях DatabasePool. Запросы одного клиента
+ * выполняются по очереди, ответы приходят в порядке запросов.
+ * Пока у клиента накоплено kMaxQueuedRequests запросов или kMaxPendingOutput байт
+ * неотправленных ответов, сервер не читает его сокет, и клиент упирается в окно TCP.
+ * Протокол описан в Protocol.hpp.
+ */
+class Server {
+public:
+    /**
+     * @brief Конструктор класса.
+     * 
+     * @param pool Пул соединений с БД.
+     * @param logger Ссылка на объект логгера.
+     * @param workers Число рабочих потоков.
+     */
+    Server(DatabasePool& pool, Logger& logger, std::size_t workers);
+
+    /**
+     * @brief Деструктор класса.
+     * 
+     * Останавливает рабочие потоки и закрывает все сокеты.
+     */
+    ~Server();
+
+    Server(const Server&) = delete;
+    Server& operator=(const Server&) = delete;
+
+    /**
+     * @brief Начинает прием соединений.
+     * 
+     * @param address Номер TCP-порта на 127.0.0.1 (0..65535, 0 - любой свободный) или путь к Unix-сокету.
+     *                Существующий по этому пути сокет заменяется; любой другой файл не трогается.
+     * @return true, если сокет открыт, иначе false.
+     */
+    bool listen(const std::string& address);
+
+    /**
+     * @brief Возвращает TCP-порт, на котором сервер принимает соединения (0 для Unix-сокета).
+     */
+    std::uint16_t port() const { return boundPort; }
+
+    /**
+     * @brief Запускает цикл обработки событий; возвращает управление после stop().
+     */
+    void run();
+
+    /**
+     * @brief Просит цикл обработки событий завершиться.
+     * 
+     * Можно вызывать из другого потока и из обработчика сигнала.
+     */
+    void stop();
+
+    // Предел разобранных, но не выполненных запросов одного клиента
+    static constexpr std::size_t kMaxQueuedRequests = 64;
+
+    // Предел неотправленных ответов одного клиента, байт
+    static constexpr std::size_t kMaxPendingOutput = 1024 * 1024;
+
+private:
+    // Состояние клиентского соединения (принадлежит потоку epoll)
+    struct Connection {
+        int fd;
+        std::string input;                 // Принятые, но еще не разобранные байты
+        std::string output;                // Байты ответов, ожидающие отправки
+        std::deque<std::string> requests;  // Разобранные запросы, ожидающие выполнения
+        bool busy = false;                 // Запрос этого клиента выполняется рабочим потоком
+        bool peerClosed = false;           // Клиент закончил передачу (read вернул 0)
+        std::uint32_t events = 0;          // События, на которые соединение подписано в epoll
+    };
+
+    // Задание для рабочего потока
+    struct Job {
+        std::uint64_t connection;
+        std::string payload;
+    };
+
+    // Готовый ответ рабочего потока
+    struct Completion {
+        std::uint64_t connection;
+        std::string frame;
+    };
+
+    void acceptConnections();
+    void handleRead(std::uint64_t id, Connection& connection);
+    bool takeRequests(std::uint64_t id, Connection& connection);
+    static bool backlogged(const Connection& connection);
+    void service(std::uint64_t id, Connection& connection);
+    bool flushOutput(Connection& connection);
+    void dispatch(std::uint64_t id, Connection& connection);
+    void drainCompletions();
+    void closeConnection(std::uint64_t id);
+    void updateInterest(std::uint64_t id, Connection& connection);
+
+    void workerLoop();
+    std::string executeRequest(const std::string& payload);
+
+    DatabasePool& pool;
+    Logger& logger;
+
+    int listenFd = -1;
+    int epollFd = -1;
+    int wakeFd = -1;            // eventfd: готовые ответы или запрос остановки
+    std::string unixPath;       // Путь Unix-сокета для удаления при остановке
+    std::uint16_t boundPort = 0;
+    std::atomic<bool> stopping{false};
+
+    std::uint64_t nextConnectionId = 2; // 0 - слушающий сокет, 1 - eventfd
+    std::unordered_map<std::uint64_t, Connection> connections;
+
+    std::vector<std::thread> workers;
+    std::deque<Job> jobs;
+    std::mutex jobsMutex;
+    std::condition_variable jobsReady;
+    bool workersStopping = false;
+
+    std::vector<Completion> completions;
+    std::mutex completionsMutex;
+};
+
+#endif // SERVER_HPP
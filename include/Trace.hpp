@@ -0,0 +1,98 @@
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include <chrono>           // Для отметок времени вызовов
+#include <cstdint>          // Для целочисленных типов фиксированного размера
+#include <fstream>          // Для записи файла трассы
+#include <initializer_list> // Для аргументов вызова
+#include <mutex>            // Для записи из нескольких соединений
+#include <string>           // Для работы со строками
+#include <string_view>      // Для аргументов без копирования
+#include <vector>           // Для прочитанных вызовов
+
+/**
+ * @brief Трасса вызовов Database для воспроизведения нагрузки.
+ * 
+ * Файл начинается с 8-байтовой сигнатуры "INVTRC01", затем идут записи:
+ * 1 байт операции, приращение времени с предыдущей записи в микросекундах (varint),
+ * число аргументов (varint) и аргументы - длина (varint) и байты.
+ * Аргументы совпадают с аргументами методов Database, числа записаны текстом.
+ */
+namespace trace {
+
+// Записываемые операции (значения совпадают с protocol::Op)
+enum class Op : std::uint8_t {
+    Search = 1, // searchEquipment(query), searchEquipmentRecords(query)
+    Get = 2,    // getEquipment(inventory_number)
+    Add = 3,    // addEquipment(name, quantity, inventory_number, room, responsible)
+    Update = 4, // updateEquipment(inventory_number, quantity, room, responsible)
+    Remove = 5  // removeEquipment(inventory_number)
+};
+
+// Прочитанный вызов
+struct Call {
+    Op op;
+    std::uint64_t time_us;          // Время от начала записи, мкс
+    std::vector<std::string> args;  // Аргументы вызова
+};
+
+/**
+ * @brief Запись трассы в файл.
+ * 
+ * Может использоваться несколькими соединениями одновременно: отметка времени
+ * берется под блокировкой, поэтому время в файле не убывает.
+ */
+class Writer {
+public:
+    /**
+     * @brief Создает файл трассы и записывает сигнатуру.
+     * 
+     * @param path Путь к файлу трассы (перезаписывается).
+     * @return true, если файл создан, иначе false.
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief Добавляет вызов в трассу.
+     */
+    void record(Op op, std::initializer_list<std::string_view> args);
+
+    /**
+     * @brief Сбрасывает буфер и закрывает файл.
+     */
+    void close();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    std::mutex mutex;           // Защищает файл и время последней записи
+    std::ofstream out;          // Файл трассы
+    Clock::time_point start;    // Начало записи
+    std::uint64_t last_us = 0;  // Время последней записи от начала, мкс
+    std::string buffer;         // Кодированная запись
+};
+
+/**
+ * @brief Возвращает путь снимка БД, который снимается при начале записи трассы.
+ * 
+ * Воспроизведение идет на копии этого снимка, чтобы трасса применялась к тому же
+ * состоянию БД, с которого началась запись.
+ */
+std::string snapshotPath(const std::string& trace_path);
+
+/**
+ * @brief Читает трассу из файла.
+ * 
+ * Если запись оборвана (процесс завершился во время записи), читаются все
+ * полные записи до обрыва.
+ * 
+ * @param path Путь к файлу трассы.
+ * @param calls Прочитанные вызовы.
+ * @param complete false, если файл оборван и последние байты пропущены.
+ * @return true, если трасса прочитана, иначе false (нет файла, чужая сигнатура).
+ */
+bool read(const std::string& path, std::vector<Call>& calls, bool& complete);
+
+} // namespace trace
+
+#endif // TRACE_HPP
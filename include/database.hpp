@@ -2,9 +2,18 @@
 #define DATABASE_HPP
 
 #include <sqlite3.h> // Библиотека SQLite3
+#include <chrono>    // Для порога медленных запросов
+#include <cstdint>   // Для целочисленных типов фиксированного размера
+#include <functional> // Для привязки параметров запросов
+#include <memory>    // Для std::unique_ptr
+#include <optional>  // Для необязательного времени истории
 #include <string>    // Для работы со строками
+#include <unordered_map> // Для подсчета строк по выражениям
 #include <vector>    // Для возврата результатов запросов
 #include "../include/Logger.hpp" // Подключаем логгер
+#include "../include/InventorySchema.hpp" // Подключаем описание таблиц
+#include "../include/ChangeNotifier.hpp" // Подключаем рассылку изменений
+#include "../include/Trace.hpp" // Подключаем запись трассы вызовов
 
 /**
  * @brief Класс для работы с базой данных SQLite3.
@@ -14,6 +23,16 @@
  */
 class Database {
 public:
+    /**
+     * @brief Результат диагностики одного канонического запроса.
+     */
+    struct QueryDiagnostic {
+        std::string name;              // Имя метода Database, которому принадлежит запрос
+        std::string sql;               // Текст запроса
+        std::vector<std::string> plan; // Строки EXPLAIN QUERY PLAN
+        bool full_scan;                // true, если план содержит полный просмотр таблицы
+    };
+
     /**
      * @brief Конструктор класса.
      * 
@@ -112,10 +131,304 @@ public:
      */
     std::vector<std::vector<std::string>> searchEquipment(const std::string& query);
 
+    /**
+     * @brief Ищет оборудование по подстроке названия или номера кабинета.
+     * 
+     * То же, что searchEquipment, но значения читаются в поля записи без
+     * преобразования чисел в текст.
+     * 
+     * @param query Подстрока для поиска.
+     * @return Найденные записи; заполнены поля name, quantity, inventory_number, room, responsible.
+     */
+    std::vector<EquipmentRecord> searchEquipmentRecords(const std::string& query);
+
+    /**
+     * @brief Возвращает оборудование по инвентарному номеру.
+     * 
+     * @param inventory_number Инвентарный номер оборудования.
+     * @return Строка результата в том же формате, что и у searchEquipment, или пустой вектор.
+     */
+    std::vector<std::string> getEquipment(const std::string& inventory_number);
+
+    /**
+     * @brief Возвращает оборудование, находящееся на этаже корпуса.
+     * 
+     * Использует индекс Classrooms(building, floor) и соединение с Equipment
+     * по индексу classroom_id.
+     * 
+     * @param building Корпус (А, Б1, Б2).
+     * @param floor Этаж.
+     * @return Строки результата в том же формате, что и у searchEquipment.
+     */
+    std::vector<std::vector<std::string>> findEquipmentByLocation(const std::string& building, int floor);
+
+    /**
+     * @brief Возвращает оборудование кабинетов с заданным назначением.
+     * 
+     * @param purpose Назначение кабинета (история, математика и т.д.).
+     * @return Строки результата в том же формате, что и у searchEquipment.
+     */
+    std::vector<std::vector<std::string>> findEquipmentByPurpose(const std::string& purpose);
+
+    /**
+     * @brief Возвращает оборудование, закрепленное за материально ответственным лицом.
+     * 
+     * @param responsible ФИО материально ответственного лица.
+     * @return Строки результата в том же формате, что и у searchEquipment.
+     */
+    std::vector<std::vector<std::string>> findEquipmentByResponsible(const std::string& responsible);
+
+    /**
+     * @brief Возвращает историю изменений единицы оборудования.
+     * 
+     * История ведется триггерами в таблице EquipmentHistory и только дополняется.
+     * 
+     * @param inventory_number Инвентарный номер оборудования.
+     * @return Строки (ts, op, name, quantity, room, responsible) в порядке изменений;
+     *         ts - миллисекунды с начала эпохи Unix, op - I (добавление), U (изменение), D (удаление).
+     */
+    std::vector<std::vector<std::string>> equipmentHistory(const std::string& inventory_number);
+
+    /**
+     * @brief Восстанавливает состав оборудования на момент времени.
+     * 
+     * Для каждого инвентарного номера берется последняя запись истории не позже ts
+     * поиском по индексу (inventory_number, ts).
+     * 
+     * @param ts Момент времени в миллисекундах с начала эпохи Unix.
+     * @return Строки результата в том же формате, что и у searchEquipment.
+     */
+    std::vector<std::vector<std::string>> inventoryAsOf(std::int64_t ts);
+
+    /**
+     * @brief Сжимает историю изменений, переносит старые записи в архив.
+     * 
+     * Записи старше before переносятся в архивную БД (или удаляются, если путь пуст).
+     * Для каждого существующего на момент before оборудования остается последняя
+     * запись, поэтому inventoryAsOf для моментов не раньше before не меняется.
+     * 
+     * @param before Граница в миллисекундах с начала эпохи Unix.
+     * @param archive_path Путь к архивной БД; пустая строка - записи удаляются без архива.
+     * @return Число перенесенных записей или -1 при ошибке.
+     */
+    long long compactHistory(std::int64_t before, const std::string& archive_path);
+
+    /**
+     * @brief Фиксирует время, которое триггеры записывают в историю изменений.
+     * 
+     * Действует только на этом соединении (временный триггер) и сбрасывается при его
+     * закрытии; схема БД не меняется. Нужно для переноса данных с известными датами и для тестов.
+     * 
+     * @param ts Время в миллисекундах с начала эпохи Unix; std::nullopt - текущее время.
+     * @return true, если время установлено.
+     */
+    bool setHistoryTime(std::optional<std::int64_t> ts);
+
+    /**
+     * @brief Включает журнал медленных запросов.
+     * 
+     * Использует sqlite3_trace_v2(SQLITE_TRACE_PROFILE). Каждый запрос, выполнявшийся
+     * не меньше порога, записывается в отдельный журнал вместе со временем выполнения,
+     * числом полученных строк и планом EXPLAIN QUERY PLAN.
+     * 
+     * @param slow_log_path Путь к файлу журнала медленных запросов.
+     * @param threshold Порог длительности запроса.
+     * @return true, если профилирование включено, иначе false.
+     */
+    bool enableProfiling(const std::string& slow_log_path, std::chrono::microseconds threshold);
+
+    /**
+     * @brief Включает журнал медленных запросов, общий для нескольких соединений.
+     * 
+     * @param log Открытый журнал медленных запросов.
+     * @param threshold Порог длительности запроса.
+     * @return true, если профилирование включено, иначе false.
+     */
+    bool enableProfiling(std::shared_ptr<Logger> log, std::chrono::microseconds threshold);
+
+    /**
+     * @brief Выключает журнал медленных запросов.
+     */
+    void disableProfiling();
+
+    /**
+     * @brief Прогоняет все канонические запросы Database через EXPLAIN QUERY PLAN.
+     * 
+     * Запросы не выполняются, строится только их план. Запросы, план которых
+     * содержит полный просмотр таблицы, помечаются флагом full_scan.
+     * 
+     * @return Результаты диагностики по каждому запросу.
+     */
+    std::vector<QueryDiagnostic> diagnoseQueries();
+
+    /**
+     * @brief Подписывает обработчик на изменения таблицы.
+     * 
+     * Изменения собираются хуками sqlite3_update_hook/commit_hook/rollback_hook
+     * и доставляются отдельным потоком одной пачкой на транзакцию только после
+     * успешного завершения COMMIT; изменения отмененных транзакций не доставляются. Несколько
+     * изменений строки в одной транзакции объединяются в одно событие.
+     * Хуки устанавливаются при первой подписке, до нее запись ничего не стоит.
+     * Вызывается после initialize().
+     * 
+     * @param table Таблица (Equipment, Classrooms, EquipmentHistory).
+     * @param callback Обработчик пачки событий; вызывается в потоке доставки и не должен
+     *                 изменять БД через это же соединение (см. ChangeNotifier::kMaxQueuedBatches).
+     * @param room Номер кабинета для фильтрации (до или после изменения); пустая строка - все.
+     *             Кабинет известен для Equipment (room) и Classrooms (room_number).
+     * @return Идентификатор подписки или -1 при ошибке.
+     */
+    int subscribe(const std::string& table, ChangeNotifier::Callback callback, const std::string& room = "");
+
+    /**
+     * @brief Отменяет подписку на изменения.
+     * 
+     * @param id Идентификатор, полученный от subscribe().
+     */
+    void unsubscribe(int id);
+
+    /**
+     * @brief Ждет доставки всех изменений зафиксированных транзакций.
+     */
+    void waitForNotifications();
+
+    /**
+     * @brief Включает запись трассы вызовов.
+     * 
+     * В трассу пишутся вызовы addEquipment, updateEquipment, removeEquipment,
+     * searchEquipment (и searchEquipmentRecords) и getEquipment с аргументами и
+     * временем от начала записи. Перед началом записи снимается копия БД
+     * (trace::snapshotPath), на которой inventory_replay воспроизводит трассу.
+     * 
+     * @param trace_path Путь к файлу трассы (перезаписывается вместе со снимком).
+     * @return true, если снимок снят и запись включена, иначе false.
+     */
+    bool startRecording(const std::string& trace_path);
+
+    /**
+     * @brief Включает запись трассы в файл, общий для нескольких соединений.
+     * 
+     * @param writer Открытый файл трассы.
+     */
+    void startRecording(std::shared_ptr<trace::Writer> writer);
+
+    /**
+     * @brief Выключает запись трассы вызовов.
+     */
+    void stopRecording();
+
+    /**
+     * @brief Сохраняет согласованную копию БД в новый файл (VACUUM INTO).
+     * 
+     * В копию попадает и содержимое WAL. Вызывается вне транзакции.
+     * 
+     * @param path Путь к копии; файла не должно быть или он должен быть пуст.
+     * @return true, если копия создана, иначе false.
+     */
+    bool backupTo(const std::string& path);
+
+    /**
+     * @brief Читает все оборудование вместе с корпусом, этажом и назначением кабинета.
+     * 
+     * Используется для загрузки EquipmentSnapshot; строки передаются по одной без накопления.
+     * 
+     * @param sink Обработчик строки.
+     * @return true, если чтение завершено без ошибок, иначе false.
+     */
+    bool readEquipmentLocations(const std::function<void(const EquipmentLocationRecord&)>& sink);
+
+    /**
+     * @brief Читает оборудование с заданными id вместе с данными кабинета.
+     * 
+     * Несуществующие id пропускаются.
+     * 
+     * @param ids Первичные ключи Equipment.
+     * @param sink Обработчик строки.
+     * @return true, если чтение завершено без ошибок, иначе false.
+     */
+    bool readEquipmentLocations(const std::vector<std::int64_t>& ids,
+                                const std::function<void(const EquipmentLocationRecord&)>& sink);
+
+    /**
+     * @brief Читает оборудование заданных кабинетов вместе с данными кабинета.
+     * 
+     * Строки ищутся по индексу Equipment(classroom_id).
+     * 
+     * @param classroom_ids Первичные ключи Classrooms.
+     * @param sink Обработчик строки.
+     * @return true, если чтение завершено без ошибок, иначе false.
+     */
+    bool readClassroomEquipmentLocations(const std::vector<std::int64_t>& classroom_ids,
+                                         const std::function<void(const EquipmentLocationRecord&)>& sink);
+
 private:
+    // Применяет миграции схемы, номер версии хранится в PRAGMA user_version
+    bool migrate();
+
+    // Применяет одну миграцию в транзакции, если текущая версия схемы ниже version
+    bool applyMigration(int version, const std::string& description, const std::function<bool()>& steps);
+
+    // Проверяет наличие столбца в таблице
+    bool columnExists(const std::string& tableName, const std::string& column);
+
+    // Возвращает подготовленное выражение из кэша, подготавливая его при первом обращении.
+    // Ключ кэша - адрес текста: sql должен жить не меньше Database (литерал или константа).
+    sqlite3_stmt* prepared(const char* sql);
+
+    // Выполняет подготовленное выражение без результата и сбрасывает его; bound - параметры привязаны
+    bool runStatement(sqlite3_stmt* stmt, bool bound);
+
+    // Выполняет подготовленный запрос и возвращает все строки результата в текстовом виде;
+    // bind привязывает параметры и возвращает false при ошибке (тогда результат пуст)
+    std::vector<std::vector<std::string>> queryRows(const char* sql,
+                                                    const std::function<bool(sqlite3_stmt*)>& bind);
+
+    // Запрос, превысивший порог профилирования
+    struct SlowQuery {
+        std::string sql;             // Текст запроса с подставленными параметрами
+        std::int64_t elapsed_ns;     // Время выполнения, нс
+        std::int64_t rows;           // Число полученных строк
+        int fullscan_steps;          // Число шагов полного просмотра таблиц
+    };
+
+    // Обработчик sqlite3_trace_v2
+    static int traceCallback(unsigned type, void* context, void* p, void* x);
+
+    // Записывает накопленные медленные запросы в журнал вместе с их планами
+    void flushSlowQueries();
+
+    // Возвращает строки EXPLAIN QUERY PLAN для запроса; пустой вектор, если план не построен
+    std::vector<std::string> explainQueryPlan(const std::string& sql);
+
+    // Выполняет подготовленный запрос оборудования с кабинетами и передает строки обработчику
+    bool stepLocations(sqlite3_stmt* stmt, const std::function<void(const EquipmentLocationRecord&)>& sink);
+
+    // Создает поток доставки изменений и устанавливает хуки соединения
+    bool enableNotifications();
+
+    // Передает подписчикам изменения транзакции, если после выражения она зафиксирована
+    void settleChanges();
+
+    // Обработчики sqlite3_update_hook, sqlite3_commit_hook и sqlite3_rollback_hook
+    static void updateHook(void* context, int operation, const char* database, const char* table, sqlite3_int64 rowid);
+    static int commitHook(void* context);
+    static void rollbackHook(void* context);
+
+    // SQL-функция inventory_change_rooms(table, rowid, old_room, new_room) для временных триггеров
+    static void changeRoomsFunction(sqlite3_context* context, int argc, sqlite3_value** argv);
+
     sqlite3* db;                  // Указатель на объект базы данных SQLite3
     std::string db_path;          // Путь к файлу базы данных
     Logger& logger;               // Ссылка на объект логгера
+    std::unordered_map<const char*, sqlite3_stmt*> statements; // Кэш подготовленных выражений
+
+    std::shared_ptr<Logger> slow_log;                         // Журнал медленных запросов (nullptr, если выключен)
+    std::chrono::nanoseconds slow_threshold{0};               // Порог медленного запроса
+    std::unordered_map<sqlite3_stmt*, std::int64_t> rows_stepped; // Строки, полученные выражениями
+    std::vector<SlowQuery> slow_queries;                      // Медленные запросы, ожидающие записи
+
+    std::unique_ptr<ChangeNotifier> notifier;                 // Рассылка изменений (nullptr до первой подписки)
+    std::shared_ptr<trace::Writer> recorder;                  // Трасса вызовов (nullptr, если запись выключена)
 };
 
 #endif // DATABASE_HPP
\ No newline at end of file
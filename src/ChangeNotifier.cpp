@@ -0,0 +1,205 @@
+#include "../include/ChangeNotifier.hpp" // Подключаем собственный заголовочный файл
+#include <algorithm>                      // Для std::sort и std::remove_if
+
+// Конструктор класса ChangeNotifier
+ChangeNotifier::ChangeNotifier(Logger& logger)
+    : logger(logger), worker(&ChangeNotifier::deliveryLoop, this) {
+}
+
+// Деструктор класса ChangeNotifier
+ChangeNotifier::~ChangeNotifier() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    changed.notify_all();
+    worker.join();
+}
+
+// Метод для регистрации подписчика
+int ChangeNotifier::subscribe(const std::string& table, const std::string& room, Callback callback) {
+    std::lock_guard<std::mutex> lock(mutex);
+    int id = nextId++;
+    subscriptions.push_back(std::make_shared<Subscription>(Subscription{id, table, room, std::move(callback)}));
+    logger.log(Logger::INFO, "Подписка #" + std::to_string(id) + " на изменения " + table +
+                             (room.empty() ? std::string() : ", кабинет " + room));
+    return id;
+}
+
+// Метод для удаления подписчика
+void ChangeNotifier::unsubscribe(int id) {
+    std::lock_guard<std::mutex> lock(mutex);
+    subscriptions.erase(std::remove_if(subscriptions.begin(), subscriptions.end(),
+                                       [id](const auto& subscription) { return subscription->id == id; }),
+                        subscriptions.end());
+}
+
+// Метод для ожидания доставки всех пачек
+void ChangeNotifier::waitIdle() {
+    std::unique_lock<std::mutex> lock(mutex);
+    changed.wait(lock, [this] { return batches.empty() && !delivering; });
+}
+
+// Метод для учета изменения строки
+void ChangeNotifier::recordChange(int operation, const char* table, sqlite3_int64 rowid) {
+    ChangeEvent::Operation kind = operation == SQLITE_INSERT ? ChangeEvent::INSERTED
+                                : operation == SQLITE_DELETE ? ChangeEvent::DELETED
+                                                             : ChangeEvent::UPDATED;
+
+    auto inserted = pending.emplace(RowKey(table, rowid), PendingChange{pendingOrder, kind, kind});
+    if (inserted.second) {
+        ++pendingOrder;
+    } else {
+        inserted.first->second.last = kind;
+    }
+}
+
+// Метод для учета кабинета строки до и после изменения
+void ChangeNotifier::recordRooms(const char* table, sqlite3_int64 rowid, const char* old_room, const char* new_room) {
+    auto inserted = rooms.emplace(RowKey(table, rowid),
+                                  std::make_pair(old_room ? old_room : "", new_room ? new_room : ""));
+    if (!inserted.second) {
+        // Кабинет до изменения берется из первого изменения в транзакции
+        inserted.first->second.second = new_room ? new_room : "";
+    }
+}
+
+// Метод для отметки начала фиксации транзакции
+void ChangeNotifier::commit() {
+    committing = true;
+}
+
+// Метод для учета результата выражения
+void ChangeNotifier::settle(bool autocommit) {
+    if (!autocommit) {
+        // Транзакция открыта: либо COMMIT еще не выполнялся, либо завершился SQLITE_BUSY
+        committing = false;
+        return;
+    }
+
+    if (committing) {
+        publish();
+    }
+    discard();
+}
+
+// Метод для передачи изменений зафиксированной транзакции в доставку
+void ChangeNotifier::publish() {
+    if (pending.empty()) {
+        return;
+    }
+
+    std::vector<std::pair<std::size_t, ChangeEvent>> ordered;
+    ordered.reserve(pending.size());
+
+    for (const auto& entry : pending) {
+        const PendingChange& change = entry.second;
+
+        // Вставка и удаление в одной транзакции взаимно уничтожаются
+        ChangeEvent::Operation operation;
+        if (change.first == ChangeEvent::INSERTED) {
+            if (change.last == ChangeEvent::DELETED) {
+                continue;
+            }
+            operation = ChangeEvent::INSERTED;
+        } else {
+            operation = change.last == ChangeEvent::DELETED ? ChangeEvent::DELETED : ChangeEvent::UPDATED;
+        }
+
+        ChangeEvent event{operation, entry.first.first, entry.first.second, "", ""};
+        auto room = rooms.find(entry.first);
+        if (room != rooms.end()) {
+            const std::string& before = room->second.first;
+            const std::string& after = room->second.second;
+            event.room = operation == ChangeEvent::DELETED ? before : after;
+            if (operation == ChangeEvent::UPDATED && before != after) {
+                event.previous_room = before;
+            }
+        }
+        ordered.emplace_back(change.order, std::move(event));
+    }
+
+    if (ordered.empty()) {
+        return;
+    }
+
+    std::sort(ordered.begin(), ordered.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    std::vector<ChangeEvent> batch;
+    batch.reserve(ordered.size());
+    for (auto& entry : ordered) {
+        batch.push_back(std::move(entry.second));
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [this] { return batches.size() < kMaxQueuedBatches; });
+        batches.push_back(std::move(batch));
+    }
+    changed.notify_all();
+}
+
+// Метод для отбрасывания изменений отмененной транзакции
+void ChangeNotifier::rollback() {
+    discard();
+}
+
+// Метод для сброса состояния завершенной транзакции
+void ChangeNotifier::discard() {
+    pending.clear();
+    rooms.clear();
+    pendingOrder = 0;
+    committing = false;
+}
+
+// Проверяет, нужно ли событие подписчику
+bool ChangeNotifier::matches(const Subscription& subscription, const ChangeEvent& event) {
+    if (event.table != subscription.table) {
+        return false;
+    }
+    return subscription.room.empty() || event.room == subscription.room ||
+           event.previous_room == subscription.room;
+}
+
+// Цикл потока доставки
+void ChangeNotifier::deliveryLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while (true) {
+        changed.wait(lock, [this] { return stopping || !batches.empty(); });
+        if (batches.empty()) {
+            return; // Остановка, все пачки доставлены
+        }
+
+        std::vector<ChangeEvent> batch = std::move(batches.front());
+        batches.pop_front();
+        changed.notify_all(); // Место в очереди для ожидающего publish()
+        auto recipients = subscriptions;
+        delivering = true;
+        lock.unlock();
+
+        for (const auto& subscription : recipients) {
+            std::vector<ChangeEvent> selected;
+            for (const auto& event : batch) {
+                if (matches(*subscription, event)) {
+                    selected.push_back(event);
+                }
+            }
+            if (selected.empty()) {
+                continue;
+            }
+
+            try {
+                subscription->callback(selected);
+            } catch (const std::exception& e) {
+                logger.log(Logger::ERROR, "Ошибка в обработчике подписки #" +
+                                          std::to_string(subscription->id) + ": " + e.what());
+            }
+        }
+
+        lock.lock();
+        delivering = false;
+        changed.notify_all();
+    }
+}
@@ -0,0 +1,71 @@
+#include "../include/DatabasePool.hpp" // Подключаем собственный заголовочный файл
+#include <cstdio>                       // Для std::remove
+#include <stdexcept>                    // Для исключений
+
+// Конструктор класса DatabasePool
+DatabasePool::DatabasePool(const std::string& db_path, std::size_t size, Logger& logger) {
+    if (size == 0) {
+        throw std::runtime_error("Пул соединений не может быть пустым");
+    }
+
+    logger.log(Logger::INFO, "Открытие пула соединений: " + std::to_string(size) + " x " + db_path);
+
+    for (std::size_t i = 0; i < size; ++i) {
+        connections.push_back(std::make_unique<Database>(db_path, logger));
+        idle.push_back(connections.back().get());
+    }
+
+    Database& first = *connections.front();
+    if (!first.execute("PRAGMA journal_mode = WAL;") || !first.initialize()) {
+        throw std::runtime_error("Не удалось инициализировать БД пула: " + db_path);
+    }
+}
+
+// Метод для включения записи трассы вызовов
+bool DatabasePool::startRecording(const std::string& trace_path) {
+    // Снимок БД для воспроизведения снимается до первой записанной операции
+    std::string snapshot = trace::snapshotPath(trace_path);
+    std::remove(snapshot.c_str());
+    if (!connections.front()->backupTo(snapshot)) {
+        return false;
+    }
+
+    auto writer = std::make_shared<trace::Writer>();
+    if (!writer->open(trace_path)) {
+        return false;
+    }
+    for (auto& connection : connections) {
+        connection->startRecording(writer);
+    }
+    return true;
+}
+
+// Метод для включения журнала медленных запросов всех соединений
+bool DatabasePool::enableProfiling(const std::string& slow_log_path, std::chrono::microseconds threshold) {
+    auto slow_log = std::make_shared<Logger>(slow_log_path);
+    for (auto& connection : connections) {
+        if (!connection->enableProfiling(slow_log, threshold)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Метод для получения соединения из пула
+DatabasePool::Lease DatabasePool::acquire() {
+    std::unique_lock<std::mutex> lock(poolMutex);
+    available.wait(lock, [this] { return !idle.empty(); });
+
+    Database* db = idle.back();
+    idle.pop_back();
+    return Lease(*this, db);
+}
+
+// Метод для возврата соединения в пул
+void DatabasePool::release(Database* db) {
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        idle.push_back(db);
+    }
+    available.notify_one();
+}
@@ -0,0 +1,319 @@
+#include "../include/EquipmentSnapshot.hpp" // Подключаем собственный заголовочный файл
+
+namespace {
+
+// Ядра фильтров и агрегатов: один проход по непрерывным массивам без ветвлений,
+// чтобы компилятор мог векторизовать цикл. Маска - 1 для отобранной строки, 0 - для остальных.
+
+// Оставляет в маске строки, у которых код столбца равен code
+void keepEqual(const std::uint32_t* column, std::size_t n, std::uint32_t code, std::uint8_t* mask) {
+    for (std::size_t i = 0; i < n; ++i) {
+        mask[i] &= static_cast<std::uint8_t>(column[i] == code);
+    }
+}
+
+// Оставляет в маске строки, у которых значение столбца лежит в [low, high]
+void keepRange(const std::int32_t* column, std::size_t n, std::int32_t low, std::int32_t high, std::uint8_t* mask) {
+    for (std::size_t i = 0; i < n; ++i) {
+        mask[i] &= static_cast<std::uint8_t>((column[i] >= low) & (column[i] <= high));
+    }
+}
+
+// Считает отобранные строки и сумму значений столбца по ним
+EquipmentSnapshot::Totals sumMasked(const std::int32_t* column, const std::uint8_t* mask, std::size_t n) {
+    std::int64_t items = 0;
+    std::int64_t sum = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        items += mask[i];
+        sum += column[i] & -static_cast<std::int32_t>(mask[i]); // Маска 1 -> все биты, 0 -> ноль
+    }
+    return {static_cast<std::size_t>(items), sum};
+}
+
+} // namespace
+
+// Метод для получения кода значения, новое значение добавляется в словарь
+EquipmentSnapshot::Code EquipmentSnapshot::Dictionary::encode(const std::string& value) {
+    auto inserted = codes.emplace(value, static_cast<Code>(values.size()));
+    if (inserted.second) {
+        values.push_back(value);
+    }
+    return inserted.first->second;
+}
+
+// Метод для поиска кода значения
+std::optional<EquipmentSnapshot::Code> EquipmentSnapshot::Dictionary::find(const std::string& value) const {
+    auto it = codes.find(value);
+    if (it == codes.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+// Метод для очистки словаря
+void EquipmentSnapshot::Dictionary::clear() {
+    values.assign(1, std::string());
+    codes.clear();
+    codes.emplace(std::string(), 0);
+}
+
+// Конструктор класса EquipmentSnapshot
+EquipmentSnapshot::EquipmentSnapshot(Database& db) : db(db) {
+    equipmentSubscription = db.subscribe("Equipment", [this](const std::vector<ChangeEvent>& events) {
+        std::lock_guard<std::mutex> lock(changesMutex);
+        for (const auto& event : events) {
+            changedEquipment.insert(event.rowid);
+        }
+    });
+    classroomsSubscription = db.subscribe("Classrooms", [this](const std::vector<ChangeEvent>& events) {
+        std::lock_guard<std::mutex> lock(changesMutex);
+        for (const auto& event : events) {
+            changedClassrooms.insert(event.rowid);
+        }
+    });
+}
+
+// Деструктор класса EquipmentSnapshot
+EquipmentSnapshot::~EquipmentSnapshot() {
+    db.unsubscribe(equipmentSubscription);
+    db.unsubscribe(classroomsSubscription);
+    // Пачка, доставка которой уже началась, еще может обращаться к снимку
+    db.waitForNotifications();
+}
+
+// Метод для полной загрузки снимка
+bool EquipmentSnapshot::load() {
+    db.waitForNotifications();
+    {
+        std::lock_guard<std::mutex> lock(changesMutex);
+        changedEquipment.clear();
+        changedClassrooms.clear();
+    }
+
+    clear();
+    if (!db.readEquipmentLocations([this](const EquipmentLocationRecord& record) { upsert(record); })) {
+        clear();
+        return false;
+    }
+    return true;
+}
+
+// Метод для применения накопленных изменений
+bool EquipmentSnapshot::refresh() {
+    if (equipmentSubscription < 0 || classroomsSubscription < 0) {
+        return load();
+    }
+
+    db.waitForNotifications();
+    std::unordered_set<std::int64_t> equipmentIds, classroomIds;
+    {
+        std::lock_guard<std::mutex> lock(changesMutex);
+        equipmentIds.swap(changedEquipment);
+        classroomIds.swap(changedClassrooms);
+    }
+
+    // Корпус, этаж и назначение хранятся в строках оборудования кабинета: они читаются
+    // из БД по индексу, без просмотра снимка. Оборудование, отвязанное от кабинета,
+    // само приходит в изменениях Equipment.
+    if (!classroomIds.empty()) {
+        std::vector<std::int64_t> classrooms(classroomIds.begin(), classroomIds.end());
+        bool ok = db.readClassroomEquipmentLocations(classrooms, [&](const EquipmentLocationRecord& record) {
+            upsert(record);
+            equipmentIds.erase(record.id);
+        });
+        if (!ok) {
+            return load();
+        }
+    }
+    if (equipmentIds.empty()) {
+        return true;
+    }
+
+    // Строки, которых больше нет в БД, удаляются из снимка
+    std::vector<std::int64_t> changed(equipmentIds.begin(), equipmentIds.end());
+    bool ok = db.readEquipmentLocations(changed, [&](const EquipmentLocationRecord& record) {
+        upsert(record);
+        equipmentIds.erase(record.id);
+    });
+    if (!ok) {
+        return load();
+    }
+
+    for (std::int64_t id : equipmentIds) {
+        erase(id);
+    }
+    return true;
+}
+
+// Метод для подсчета итогов по условию
+EquipmentSnapshot::Totals EquipmentSnapshot::totals(const Filter& filter) const {
+    std::vector<std::uint8_t> mask;
+    if (!select(filter, mask)) {
+        return {};
+    }
+    return sumMasked(quantities.data(), mask.data(), mask.size());
+}
+
+// Метод для группировки итогов по столбцу
+std::vector<std::pair<std::string, EquipmentSnapshot::Totals>>
+EquipmentSnapshot::totalsBy(Dimension dimension, const Filter& filter) const {
+    std::vector<std::pair<std::string, Totals>> result;
+    std::vector<std::uint8_t> mask;
+    if (!select(filter, mask)) {
+        return result;
+    }
+
+    const std::vector<Code>* column;
+    const Dictionary* dictionary;
+    switch (dimension) {
+        case ROOM: column = &rooms; dictionary = &roomDictionary; break;
+        case RESPONSIBLE: column = &responsibles; dictionary = &responsibleDictionary; break;
+        case BUILDING: column = &buildings; dictionary = &buildingDictionary; break;
+        default: column = &purposes; dictionary = &purposeDictionary; break;
+    }
+
+    std::vector<Totals> groups(dictionary->size());
+    const Code* codes = column->data();
+    for (std::size_t i = 0; i < mask.size(); ++i) {
+        Totals& group = groups[codes[i]];
+        group.items += mask[i];
+        group.quantity += quantities[i] & -static_cast<std::int32_t>(mask[i]);
+    }
+
+    for (std::size_t code = 0; code < groups.size(); ++code) {
+        if (groups[code].items > 0) {
+            result.emplace_back(dictionary->decode(static_cast<Code>(code)), groups[code]);
+        }
+    }
+    return result;
+}
+
+// Метод для получения инвентарных номеров по условию
+std::vector<std::string> EquipmentSnapshot::inventoryNumbers(const Filter& filter) const {
+    std::vector<std::string> result;
+    std::vector<std::uint8_t> mask;
+    if (!select(filter, mask)) {
+        return result;
+    }
+
+    for (std::size_t i = 0; i < mask.size(); ++i) {
+        if (mask[i]) {
+            result.push_back(inventory_numbers[i]);
+        }
+    }
+    return result;
+}
+
+// Метод для построения маски отобранных строк
+bool EquipmentSnapshot::select(const Filter& filter, std::vector<std::uint8_t>& mask) const {
+    std::size_t n = ids.size();
+    mask.assign(n, 1);
+
+    // Значения, которого нет в словаре, нет ни в одной строке
+    auto keep = [&](const std::optional<std::string>& value, const Dictionary& dictionary,
+                    const std::vector<Code>& column) {
+        if (!value) {
+            return true;
+        }
+        auto code = dictionary.find(*value);
+        if (!code) {
+            return false;
+        }
+        keepEqual(column.data(), n, *code, mask.data());
+        return true;
+    };
+
+    if (!keep(filter.room, roomDictionary, rooms) ||
+        !keep(filter.responsible, responsibleDictionary, responsibles) ||
+        !keep(filter.building, buildingDictionary, buildings) ||
+        !keep(filter.purpose, purposeDictionary, purposes)) {
+        mask.clear();
+        return false;
+    }
+
+    if (filter.floor) {
+        if (*filter.floor == kNoFloor) {
+            mask.clear();
+            return false;
+        }
+        keepRange(floors.data(), n, *filter.floor, *filter.floor, mask.data());
+    }
+    if (filter.min_quantity != std::numeric_limits<int>::min() ||
+        filter.max_quantity != std::numeric_limits<int>::max()) {
+        keepRange(quantities.data(), n, filter.min_quantity, filter.max_quantity, mask.data());
+    }
+    return true;
+}
+
+// Метод для добавления или замены строки снимка
+void EquipmentSnapshot::upsert(const EquipmentLocationRecord& record) {
+    auto inserted = positions.emplace(record.id, ids.size());
+    std::size_t row = inserted.first->second;
+    if (inserted.second) {
+        ids.push_back(record.id);
+        inventory_numbers.emplace_back();
+        quantities.push_back(0);
+        floors.push_back(kNoFloor);
+        rooms.push_back(0);
+        responsibles.push_back(0);
+        buildings.push_back(0);
+        purposes.push_back(0);
+    }
+
+    inventory_numbers[row] = record.inventory_number;
+    quantities[row] = record.quantity;
+    floors[row] = record.floor.value_or(kNoFloor);
+    rooms[row] = roomDictionary.encode(record.room);
+    responsibles[row] = responsibleDictionary.encode(record.responsible);
+    buildings[row] = record.building ? buildingDictionary.encode(*record.building) : 0;
+    purposes[row] = record.purpose ? purposeDictionary.encode(*record.purpose) : 0;
+}
+
+// Метод для удаления строки снимка: на ее место переносится последняя строка
+void EquipmentSnapshot::erase(std::int64_t id) {
+    auto it = positions.find(id);
+    if (it == positions.end()) {
+        return;
+    }
+
+    std::size_t row = it->second;
+    std::size_t last = ids.size() - 1;
+    positions.erase(it);
+    if (row != last) {
+        ids[row] = ids[last];
+        inventory_numbers[row] = std::move(inventory_numbers[last]);
+        quantities[row] = quantities[last];
+        floors[row] = floors[last];
+        rooms[row] = rooms[last];
+        responsibles[row] = responsibles[last];
+        buildings[row] = buildings[last];
+        purposes[row] = purposes[last];
+        positions[ids[row]] = row;
+    }
+
+    ids.pop_back();
+    inventory_numbers.pop_back();
+    quantities.pop_back();
+    floors.pop_back();
+    rooms.pop_back();
+    responsibles.pop_back();
+    buildings.pop_back();
+    purposes.pop_back();
+}
+
+// Метод для очистки снимка
+void EquipmentSnapshot::clear() {
+    ids.clear();
+    inventory_numbers.clear();
+    quantities.clear();
+    floors.clear();
+    rooms.clear();
+    responsibles.clear();
+    buildings.clear();
+    purposes.clear();
+    positions.clear();
+    roomDictionary.clear();
+    responsibleDictionary.clear();
+    buildingDictionary.clear();
+    purposeDictionary.clear();
+}
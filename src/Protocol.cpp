@@ -0,0 +1,274 @@
+#include "../include/Protocol.hpp" // Подключаем собственный заголовочный файл
+#include <arpa/inet.h>             // Для htonl/ntohl и inet_pton
+#include <cerrno>                  // Для errno
+#include <cstring>                 // Для memcpy
+#include <netinet/in.h>            // Для sockaddr_in
+#include <netinet/tcp.h>           // Для TCP_NODELAY
+#include <stdexcept>               // Для исключений разбора порта
+#include <sys/socket.h>            // Для сокетов
+#include <sys/un.h>                // Для sockaddr_un
+#include <unistd.h>                // Для read/write/close
+
+namespace protocol {
+
+namespace {
+
+void putU32(std::string& out, std::uint32_t value) {
+    std::uint32_t be = htonl(value);
+    out.append(reinterpret_cast<const char*>(&be), sizeof(be));
+}
+
+void putString(std::string& out, const std::string& value) {
+    putU32(out, static_cast<std::uint32_t>(value.size()));
+    out += value;
+}
+
+// Последовательное чтение тела кадра с проверкой границ
+class Reader {
+public:
+    explicit Reader(const std::string& data) : data(data) {}
+
+    bool u8(std::uint8_t& value) {
+        if (pos + 1 > data.size()) {
+            return false;
+        }
+        value = static_cast<std::uint8_t>(data[pos++]);
+        return true;
+    }
+
+    bool u32(std::uint32_t& value) {
+        if (pos + sizeof(value) > data.size()) {
+            return false;
+        }
+        std::memcpy(&value, data.data() + pos, sizeof(value));
+        value = ntohl(value);
+        pos += sizeof(value);
+        return true;
+    }
+
+    bool string(std::string& value) {
+        std::uint32_t length;
+        if (!u32(length) || length > data.size() - pos) {
+            return false;
+        }
+        value.assign(data, pos, length);
+        pos += length;
+        return true;
+    }
+
+    bool done() const { return pos == data.size(); }
+
+private:
+    const std::string& data;
+    std::size_t pos = 0;
+};
+
+bool writeAll(int fd, const std::string& data) {
+    std::size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t n = ::write(fd, data.data() + sent, data.size() - sent);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        sent += static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+bool readExact(int fd, char* data, std::size_t size) {
+    std::size_t received = 0;
+    while (received < size) {
+        ssize_t n = ::read(fd, data + received, size - received);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        received += static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+} // namespace
+
+std::string encodeRequest(const Request& request) {
+    std::string out;
+    out.push_back(static_cast<char>(request.op));
+    putU32(out, static_cast<std::uint32_t>(request.args.size()));
+    for (const auto& arg : request.args) {
+        putString(out, arg);
+    }
+    return out;
+}
+
+bool decodeRequest(const std::string& payload, Request& request) {
+    Reader reader(payload);
+    std::uint8_t op;
+    std::uint32_t count;
+    if (!reader.u8(op) || op < static_cast<std::uint8_t>(Op::Search) ||
+        op > static_cast<std::uint8_t>(Op::Remove) || !reader.u32(count)) {
+        return false;
+    }
+
+    request.op = static_cast<Op>(op);
+    request.args.clear();
+    for (std::uint32_t i = 0; i < count; ++i) {
+        std::string arg;
+        if (!reader.string(arg)) {
+            return false;
+        }
+        request.args.push_back(std::move(arg));
+    }
+    return reader.done();
+}
+
+std::string encodeResponse(const Response& response) {
+    std::string out;
+    out.push_back(static_cast<char>(response.status));
+    putU32(out, static_cast<std::uint32_t>(response.rows.size()));
+    for (const auto& row : response.rows) {
+        putU32(out, static_cast<std::uint32_t>(row.size()));
+        for (const auto& value : row) {
+            putString(out, value);
+        }
+    }
+    return out;
+}
+
+bool decodeResponse(const std::string& payload, Response& response) {
+    Reader reader(payload);
+    std::uint8_t status;
+    std::uint32_t rowCount;
+    if (!reader.u8(status) || status > static_cast<std::uint8_t>(Status::Error) || !reader.u32(rowCount)) {
+        return false;
+    }
+
+    response.status = static_cast<Status>(status);
+    response.rows.clear();
+    for (std::uint32_t i = 0; i < rowCount; ++i) {
+        std::uint32_t colCount;
+        if (!reader.u32(colCount)) {
+            return false;
+        }
+        std::vector<std::string> row;
+        for (std::uint32_t j = 0; j < colCount; ++j) {
+            std::string value;
+            if (!reader.string(value)) {
+                return false;
+            }
+            row.push_back(std::move(value));
+        }
+        response.rows.push_back(std::move(row));
+    }
+    return reader.done();
+}
+
+std::string frame(const std::string& payload) {
+    std::string out;
+    out.reserve(sizeof(std::uint32_t) + payload.size());
+    putU32(out, static_cast<std::uint32_t>(payload.size()));
+    out += payload;
+    return out;
+}
+
+int takeFrame(std::string& buffer, std::string& payload) {
+    std::uint32_t length;
+    if (buffer.size() < sizeof(length)) {
+        return 0;
+    }
+    std::memcpy(&length, buffer.data(), sizeof(length));
+    length = ntohl(length);
+
+    if (length > kMaxFrameSize) {
+        return -1;
+    }
+    if (buffer.size() < sizeof(length) + length) {
+        return 0;
+    }
+
+    payload.assign(buffer, sizeof(length), length);
+    buffer.erase(0, sizeof(length) + length);
+    return 1;
+}
+
+bool isPortAddress(const std::string& address) {
+    return !address.empty() && address.find_first_not_of("0123456789") == std::string::npos;
+}
+
+bool parsePort(const std::string& address, std::uint16_t& port) {
+    unsigned long value = 0;
+    try {
+        value = std::stoul(address);
+    } catch (const std::exception&) {
+        return false;
+    }
+    if (value > 65535) {
+        return false;
+    }
+    port = static_cast<std::uint16_t>(value);
+    return true;
+}
+
+int connectTo(const std::string& address) {
+    bool isPort = isPortAddress(address);
+    std::uint16_t port = 0;
+    if (isPort && (!parsePort(address, port) || port == 0)) {
+        return -1;
+    }
+
+    int fd = ::socket(isPort ? AF_INET : AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return -1;
+    }
+
+    int rc;
+    if (isPort) {
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+        rc = ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    } else {
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        if (address.size() >= sizeof(addr.sun_path)) {
+            ::close(fd);
+            return -1;
+        }
+        std::memcpy(addr.sun_path, address.c_str(), address.size() + 1);
+        rc = ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    }
+
+    if (rc != 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+bool call(int fd, const Request& request, Response& response) {
+    if (!writeAll(fd, frame(encodeRequest(request)))) {
+        return false;
+    }
+
+    std::uint32_t length;
+    if (!readExact(fd, reinterpret_cast<char*>(&length), sizeof(length))) {
+        return false;
+    }
+    length = ntohl(length);
+    if (length > kMaxFrameSize) {
+        return false;
+    }
+
+    std::string payload(length, '\0');
+    return readExact(fd, &payload[0], length) && decodeResponse(payload, response);
+}
+
+} // namespace protocol
@@ -0,0 +1,510 @@
+#include "../include/Server.hpp"   // Подключаем собственный заголовочный файл
+#include "../include/Protocol.hpp" // Подключаем протокол обмена
+#include <algorithm>               // Для std::max
+#include <arpa/inet.h>             // Для htons и inet_pton
+#include <cerrno>                  // Для errno
+#include <cstring>                 // Для strerror и memcpy
+#include <netinet/in.h>            // Для sockaddr_in
+#include <netinet/tcp.h>           // Для TCP_NODELAY
+#include <stdexcept>               // Для исключений
+#include <sys/epoll.h>             // Для epoll
+#include <sys/eventfd.h>           // Для eventfd
+#include <sys/socket.h>            // Для сокетов
+#include <sys/stat.h>              // Для lstat
+#include <sys/un.h>                // Для sockaddr_un
+#include <unistd.h>                // Для read/write/close/unlink
+
+namespace {
+
+// Идентификаторы служебных дескрипторов в epoll_event.data.u64
+constexpr std::uint64_t kListenId = 0;
+constexpr std::uint64_t kWakeId = 1;
+
+// Разбирает количество из аргумента запроса
+int parseQuantity(const std::string& value) {
+    std::size_t used = 0;
+    int quantity = 0;
+    try {
+        quantity = std::stoi(value, &used);
+    } catch (const std::exception&) {
+        used = 0;
+    }
+    if (used == 0 || used != value.size()) {
+        throw std::invalid_argument("Некорректное количество: " + value);
+    }
+    return quantity;
+}
+
+// Проверяет число аргументов запроса
+void expectArgs(const protocol::Request& request, std::size_t count) {
+    if (request.args.size() != count) {
+        throw std::invalid_argument("Ожидалось аргументов: " + std::to_string(count) +
+                                    ", получено: " + std::to_string(request.args.size()));
+    }
+}
+
+} // namespace
+
+// Конструктор класса Server
+Server::Server(DatabasePool& pool, Logger& logger, std::size_t workerCount)
+    : pool(pool), logger(logger) {
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epollFd < 0 || wakeFd < 0) {
+        throw std::runtime_error("Не удалось создать epoll/eventfd: " + std::string(std::strerror(errno)));
+    }
+
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.u64 = kWakeId;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event);
+
+    for (std::size_t i = 0; i < std::max<std::size_t>(workerCount, 1); ++i) {
+        workers.emplace_back(&Server::workerLoop, this);
+    }
+}
+
+// Деструктор класса Server
+Server::~Server() {
+    {
+        std::lock_guard<std::mutex> lock(jobsMutex);
+        workersStopping = true;
+    }
+    jobsReady.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    for (auto& entry : connections) {
+        ::close(entry.second.fd);
+    }
+    if (listenFd >= 0) {
+        ::close(listenFd);
+    }
+    struct stat info;
+    if (!unixPath.empty() && ::lstat(unixPath.c_str(), &info) == 0 && S_ISSOCK(info.st_mode)) {
+        ::unlink(unixPath.c_str());
+    }
+    ::close(wakeFd);
+    ::close(epollFd);
+}
+
+// Метод для открытия слушающего сокета
+bool Server::listen(const std::string& address) {
+    bool isPort = protocol::isPortAddress(address);
+    std::uint16_t port = 0;
+    if (isPort && !protocol::parsePort(address, port)) {
+        logger.log(Logger::ERROR, "Некорректный номер порта: " + address);
+        return false;
+    }
+
+    listenFd = ::socket(isPort ? AF_INET : AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listenFd < 0) {
+        logger.log(Logger::ERROR, "Не удалось создать сокет: " + std::string(std::strerror(errno)));
+        return false;
+    }
+
+    int rc;
+    if (isPort) {
+        int one = 1;
+        setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+        rc = ::bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+
+        socklen_t length = sizeof(addr);
+        if (rc == 0 && getsockname(listenFd, reinterpret_cast<sockaddr*>(&addr), &length) == 0) {
+            boundPort = ntohs(addr.sin_port);
+        }
+    } else {
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        if (address.size() >= sizeof(addr.sun_path)) {
+            logger.log(Logger::ERROR, "Слишком длинный путь Unix-сокета: " + address);
+            return false;
+        }
+        std::memcpy(addr.sun_path, address.c_str(), address.size() + 1);
+
+        // Сокет, оставшийся от предыдущего запуска, мешает bind; другие файлы не удаляются
+        struct stat info;
+        if (::lstat(address.c_str(), &info) == 0) {
+            if (!S_ISSOCK(info.st_mode)) {
+                logger.log(Logger::ERROR, "Путь занят и не является Unix-сокетом: " + address);
+                return false;
+            }
+            ::unlink(address.c_str());
+        }
+        rc = ::bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        if (rc == 0) {
+            unixPath = address;
+        }
+    }
+
+    if (rc != 0 || ::listen(listenFd, SOMAXCONN) != 0) {
+        logger.log(Logger::ERROR, "Не удалось открыть сокет " + address + ": " + std::strerror(errno));
+        return false;
+    }
+
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.u64 = kListenId;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event);
+
+    logger.log(Logger::INFO, "Сервер принимает соединения: " +
+                             (isPort ? "127.0.0.1:" + std::to_string(boundPort) : address));
+    return true;
+}
+
+// Цикл обработки событий
+void Server::run() {
+    epoll_event events[64];
+
+    while (!stopping) {
+        int count = epoll_wait(epollFd, events, 64, -1);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            logger.log(Logger::ERROR, "Ошибка epoll_wait: " + std::string(std::strerror(errno)));
+            break;
+        }
+
+        for (int i = 0; i < count; ++i) {
+            std::uint64_t id = events[i].data.u64;
+
+            if (id == kListenId) {
+                acceptConnections();
+                continue;
+            }
+
+            if (id == kWakeId) {
+                std::uint64_t value;
+                while (::read(wakeFd, &value, sizeof(value)) > 0) {
+                }
+                drainCompletions();
+                continue;
+            }
+
+            auto it = connections.find(id);
+            if (it == connections.end()) {
+                continue; // Соединение закрыто ранее в этой же пачке событий
+            }
+
+            if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+                handleRead(id, it->second);
+                it = connections.find(id);
+                if (it == connections.end()) {
+                    continue;
+                }
+            }
+
+            if (events[i].events & EPOLLOUT) {
+                service(id, it->second);
+            }
+        }
+    }
+
+    logger.log(Logger::INFO, "Сервер остановлен");
+}
+
+// Метод для запроса остановки
+void Server::stop() {
+    stopping = true;
+    std::uint64_t one = 1;
+    ssize_t written = ::write(wakeFd, &one, sizeof(one));
+    (void)written;
+}
+
+// Метод для приема новых соединений
+void Server::acceptConnections() {
+    while (true) {
+        int fd = ::accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                logger.log(Logger::WARNING, "Ошибка accept: " + std::string(std::strerror(errno)));
+            }
+            return;
+        }
+
+        if (unixPath.empty()) {
+            int one = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        }
+
+        std::uint64_t id = nextConnectionId++;
+        Connection connection;
+        connection.fd = fd;
+        connection.events = EPOLLIN;
+        connections.emplace(id, std::move(connection));
+
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.u64 = id;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+        logger.log(Logger::INFO, "Новое соединение #" + std::to_string(id));
+    }
+}
+
+// Метод для чтения входящих кадров
+void Server::handleRead(std::uint64_t id, Connection& connection) {
+    char buffer[64 * 1024];
+
+    // При заполненных очередях данные остаются в сокете до выполнения накопленных запросов
+    while (!connection.peerClosed && !backlogged(connection)) {
+        ssize_t n = ::read(connection.fd, buffer, sizeof(buffer));
+        if (n > 0) {
+            connection.input.append(buffer, static_cast<std::size_t>(n));
+            if (!takeRequests(id, connection)) {
+                closeConnection(id);
+                return;
+            }
+            continue;
+        }
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        }
+        if (n < 0) {
+            closeConnection(id);
+            return;
+        }
+
+        // Клиент закончил передачу: уже принятые запросы выполняются, ответы отправляются
+        connection.peerClosed = true;
+    }
+
+    service(id, connection);
+}
+
+// Метод для разбора принятых кадров; false - кадр превышает допустимый размер
+bool Server::takeRequests(std::uint64_t id, Connection& connection) {
+    std::string payload;
+    int rc = 0;
+    while (connection.requests.size() < kMaxQueuedRequests &&
+           (rc = protocol::takeFrame(connection.input, payload)) == 1) {
+        connection.requests.push_back(std::move(payload));
+    }
+
+    if (rc < 0) {
+        logger.log(Logger::WARNING, "Соединение #" + std::to_string(id) + ": кадр превышает допустимый размер");
+        return false;
+    }
+    return true;
+}
+
+// Проверяет, заполнены ли очереди соединения
+bool Server::backlogged(const Connection& connection) {
+    return connection.requests.size() >= kMaxQueuedRequests || connection.output.size() >= kMaxPendingOutput;
+}
+
+// Метод для продвижения соединения: выполнение запросов, отправка ответов, закрытие
+void Server::service(std::uint64_t id, Connection& connection) {
+    if (!takeRequests(id, connection)) {
+        closeConnection(id);
+        return;
+    }
+    dispatch(id, connection);
+
+    if (!flushOutput(connection)) {
+        closeConnection(id);
+        return;
+    }
+
+    // Отключившийся клиент закрывается, когда все его запросы выполнены и ответы отправлены
+    if (connection.peerClosed && !connection.busy && connection.requests.empty() && connection.output.empty()) {
+        closeConnection(id);
+        return;
+    }
+    updateInterest(id, connection);
+}
+
+// Метод для отправки накопленных ответов; false - соединение нужно закрыть
+bool Server::flushOutput(Connection& connection) {
+    std::size_t sent = 0;
+    while (sent < connection.output.size()) {
+        ssize_t n = ::send(connection.fd, connection.output.data() + sent,
+                           connection.output.size() - sent, MSG_NOSIGNAL);
+        if (n > 0) {
+            sent += static_cast<std::size_t>(n);
+            continue;
+        }
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        }
+        return false;
+    }
+
+    connection.output.erase(0, sent);
+    return true;
+}
+
+// Метод для передачи следующего запроса клиента рабочему потоку
+void Server::dispatch(std::uint64_t id, Connection& connection) {
+    // Следующий запрос ждет, пока клиент не заберет накопленные ответы
+    if (connection.busy || connection.requests.empty() || connection.output.size() >= kMaxPendingOutput) {
+        return;
+    }
+
+    connection.busy = true;
+    {
+        std::lock_guard<std::mutex> lock(jobsMutex);
+        jobs.push_back(Job{id, std::move(connection.requests.front())});
+    }
+    connection.requests.pop_front();
+    jobsReady.notify_one();
+}
+
+// Метод для обработки ответов, готовых у рабочих потоков
+void Server::drainCompletions() {
+    std::vector<Completion> ready;
+    {
+        std::lock_guard<std::mutex> lock(completionsMutex);
+        ready.swap(completions);
+    }
+
+    for (auto& completion : ready) {
+        auto it = connections.find(completion.connection);
+        if (it == connections.end()) {
+            continue; // Клиент отключился, пока запрос выполнялся
+        }
+
+        Connection& connection = it->second;
+        connection.output += completion.frame;
+        connection.busy = false;
+        service(completion.connection, connection);
+    }
+}
+
+// Метод для подписки на EPOLLIN, пока очереди не заполнены, и на EPOLLOUT, пока есть неотправленные данные
+void Server::updateInterest(std::uint64_t id, Connection& connection) {
+    std::uint32_t wanted = 0;
+    if (!connection.peerClosed && !backlogged(connection)) {
+        wanted |= EPOLLIN;
+    }
+    if (!connection.output.empty()) {
+        wanted |= EPOLLOUT;
+    }
+    if (wanted == connection.events) {
+        return;
+    }
+
+    // Без событий дескриптор снимается с epoll: EPOLLHUP сообщается всегда и будил бы цикл впустую
+    epoll_event event{};
+    event.events = wanted;
+    event.data.u64 = id;
+    int op = wanted == 0 ? EPOLL_CTL_DEL : (connection.events == 0 ? EPOLL_CTL_ADD : EPOLL_CTL_MOD);
+    epoll_ctl(epollFd, op, connection.fd, &event);
+    connection.events = wanted;
+}
+
+// Метод для закрытия соединения
+void Server::closeConnection(std::uint64_t id) {
+    auto it = connections.find(id);
+    if (it == connections.end()) {
+        return;
+    }
+
+    if (it->second.events != 0) {
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, it->second.fd, nullptr);
+    }
+    ::close(it->second.fd);
+    connections.erase(it);
+    logger.log(Logger::INFO, "Соединение #" + std::to_string(id) + " закрыто");
+}
+
+// Цикл рабочего потока
+void Server::workerLoop() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(jobsMutex);
+            jobsReady.wait(lock, [this] { return workersStopping || !jobs.empty(); });
+            if (workersStopping) {
+                return;
+            }
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+
+        std::string response = protocol::frame(executeRequest(job.payload));
+        {
+            std::lock_guard<std::mutex> lock(completionsMutex);
+            completions.push_back(Completion{job.connection, std::move(response)});
+        }
+
+        std::uint64_t one = 1;
+        ssize_t written = ::write(wakeFd, &one, sizeof(one));
+        (void)written;
+    }
+}
+
+// Метод для выполнения запроса на соединении из пула
+std::string Server::executeRequest(const std::string& payload) {
+    protocol::Request request;
+    protocol::Response response{protocol::Status::Ok, {}};
+
+    if (!protocol::decodeRequest(payload, request)) {
+        response.status = protocol::Status::Error;
+        response.rows.push_back({"Некорректный запрос"});
+        return protocol::encodeResponse(response);
+    }
+
+    try {
+        auto db = pool.acquire();
+        bool ok = true;
+
+        switch (request.op) {
+            case protocol::Op::Search:
+                expectArgs(request, 1);
+                response.rows = db->searchEquipment(request.args[0]);
+                break;
+
+            case protocol::Op::Get: {
+                expectArgs(request, 1);
+                auto row = db->getEquipment(request.args[0]);
+                if (!row.empty()) {
+                    response.rows.push_back(std::move(row));
+                }
+                break;
+            }
+
+            case protocol::Op::Add:
+                expectArgs(request, 5);
+                ok = db->addEquipment(request.args[0], parseQuantity(request.args[1]),
+                                      request.args[2], request.args[3], request.args[4]);
+                break;
+
+            case protocol::Op::Update:
+                expectArgs(request, 4);
+                ok = db->updateEquipment(request.args[0], parseQuantity(request.args[1]),
+                                         request.args[2], request.args[3]);
+                break;
+
+            case protocol::Op::Remove:
+                expectArgs(request, 1);
+                ok = db->removeEquipment(request.args[0]);
+                break;
+        }
+
+        if (!ok) {
+            response.status = protocol::Status::Error;
+            response.rows.push_back({"Операция не выполнена"});
+        }
+    } catch (const std::exception& e) {
+        response.status = protocol::Status::Error;
+        response.rows.assign(1, {e.what()});
+    }
+
+    return protocol::encodeResponse(response);
+}
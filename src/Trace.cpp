@@ -0,0 +1,154 @@
+#include "../include/Trace.hpp" // Подключаем собственный заголовочный файл
+#include <iterator>              // Для чтения файла целиком
+
+namespace trace {
+
+namespace {
+
+const char kMagic[8] = {'I', 'N', 'V', 'T', 'R', 'C', '0', '1'};
+
+void putVarint(std::string& out, std::uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+// Последовательное чтение записей с проверкой границ
+class Reader {
+public:
+    explicit Reader(const std::string& data, std::size_t pos) : data(data), pos(pos) {}
+
+    bool u8(std::uint8_t& value) {
+        if (pos >= data.size()) {
+            return false;
+        }
+        value = static_cast<std::uint8_t>(data[pos++]);
+        return true;
+    }
+
+    bool varint(std::uint64_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            std::uint8_t byte;
+            if (!u8(byte)) {
+                return false;
+            }
+            value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool string(std::string& value) {
+        std::uint64_t length;
+        if (!varint(length) || length > data.size() - pos) {
+            return false;
+        }
+        value.assign(data, pos, static_cast<std::size_t>(length));
+        pos += static_cast<std::size_t>(length);
+        return true;
+    }
+
+    bool done() const { return pos == data.size(); }
+
+private:
+    const std::string& data;
+    std::size_t pos;
+};
+
+} // namespace
+
+// Метод для создания файла трассы
+bool Writer::open(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex);
+    out.open(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        return false;
+    }
+    out.write(kMagic, sizeof(kMagic));
+    start = Clock::now();
+    last_us = 0;
+    return static_cast<bool>(out);
+}
+
+// Метод для записи вызова
+void Writer::record(Op op, std::initializer_list<std::string_view> args) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!out.is_open()) {
+        return;
+    }
+
+    auto now_us = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count());
+    if (now_us < last_us) {
+        now_us = last_us;
+    }
+
+    buffer.clear();
+    buffer.push_back(static_cast<char>(op));
+    putVarint(buffer, now_us - last_us);
+    putVarint(buffer, args.size());
+    for (std::string_view arg : args) {
+        putVarint(buffer, arg.size());
+        buffer.append(arg.data(), arg.size());
+    }
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    last_us = now_us;
+}
+
+// Метод для закрытия файла трассы
+void Writer::close() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (out.is_open()) {
+        out.close();
+    }
+}
+
+// Функция для получения пути к снимку БД трассы (путь трассы с суффиксом .db)
+std::string snapshotPath(const std::string& trace_path) {
+    return trace_path + ".db";
+}
+
+// Функция для чтения трассы
+bool read(const std::string& path, std::vector<Call>& calls, bool& complete) {
+    complete = true;
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        return false;
+    }
+    std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (data.size() < sizeof(kMagic) || data.compare(0, sizeof(kMagic), kMagic, sizeof(kMagic)) != 0) {
+        return false;
+    }
+
+    Reader reader(data, sizeof(kMagic));
+    std::uint64_t time_us = 0;
+    while (!reader.done()) {
+        std::uint8_t op;
+        std::uint64_t delta, count;
+        if (!reader.u8(op) || op < static_cast<std::uint8_t>(Op::Search) ||
+            op > static_cast<std::uint8_t>(Op::Remove) || !reader.varint(delta) || !reader.varint(count)) {
+            complete = false;
+            return true;
+        }
+
+        time_us += delta;
+        Call call{static_cast<Op>(op), time_us, {}};
+        for (std::uint64_t i = 0; i < count; ++i) {
+            std::string arg;
+            if (!reader.string(arg)) {
+                complete = false;
+                return true;
+            }
+            call.args.push_back(std::move(arg));
+        }
+        calls.push_back(std::move(call));
+    }
+    return true;
+}
+
+} // namespace trace
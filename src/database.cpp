@@ -1,7 +1,202 @@
 #include "../include/database.hpp" // Подключаем собственный заголовочный файл
 #include <fstream>                 // Для работы с файлами
 #include <stdexcept>               // Для исключений
+#include <cstdio>                  // Для std::remove
 #include <cstring>                 // Для работы со строками C-style
+#include <iomanip>                 // Для форматирования времени выполнения
+#include <map>                     // Для глубины узлов плана запроса
+#include <sstream>                 // Для формирования записей журнала
+
+namespace {
+
+// Схема версии 1: вторичные индексы и поддержание связи Equipment.classroom_id -> Classrooms.id.
+// Столбец room остается свободным текстом, classroom_id заполняется триггерами,
+// если кабинет с таким номером есть в Classrooms. addEquipment и updateEquipment задают
+// classroom_id в самом запросе, поэтому триггеры Equipment изменяют строку только при неверной связи.
+const char* const kSchemaV1Sql = R"(
+    CREATE INDEX IF NOT EXISTS idx_equipment_room ON Equipment(room);
+    CREATE INDEX IF NOT EXISTS idx_equipment_responsible
+        ON Equipment(responsible, name, quantity, inventory_number, room);
+    CREATE INDEX IF NOT EXISTS idx_equipment_classroom
+        ON Equipment(classroom_id, name, quantity, inventory_number, room, responsible);
+    CREATE INDEX IF NOT EXISTS idx_classrooms_location ON Classrooms(building, floor);
+    CREATE INDEX IF NOT EXISTS idx_classrooms_purpose ON Classrooms(purpose);
+
+    CREATE TRIGGER IF NOT EXISTS trg_equipment_link_insert AFTER INSERT ON Equipment
+    WHEN NEW.classroom_id IS NOT (SELECT id FROM Classrooms WHERE room_number = NEW.room)
+    BEGIN
+        UPDATE Equipment SET classroom_id = (SELECT id FROM Classrooms WHERE room_number = NEW.room)
+        WHERE id = NEW.id;
+    END;
+
+    CREATE TRIGGER IF NOT EXISTS trg_equipment_link_update AFTER UPDATE OF room ON Equipment
+    WHEN NEW.classroom_id IS NOT (SELECT id FROM Classrooms WHERE room_number = NEW.room)
+    BEGIN
+        UPDATE Equipment SET classroom_id = (SELECT id FROM Classrooms WHERE room_number = NEW.room)
+        WHERE id = NEW.id;
+    END;
+
+    CREATE TRIGGER IF NOT EXISTS trg_classrooms_link_insert AFTER INSERT ON Classrooms
+    BEGIN
+        UPDATE Equipment SET classroom_id = NEW.id WHERE room = NEW.room_number;
+    END;
+
+    CREATE TRIGGER IF NOT EXISTS trg_classrooms_link_update AFTER UPDATE OF room_number ON Classrooms
+    BEGIN
+        UPDATE Equipment SET classroom_id = NULL WHERE classroom_id = NEW.id;
+        UPDATE Equipment SET classroom_id = NEW.id WHERE room = NEW.room_number;
+    END;
+
+    UPDATE Equipment SET classroom_id = (SELECT id FROM Classrooms WHERE room_number = Equipment.room);
+)";
+
+// Схема версии 2: история перемещений оборудования, заполняемая триггерами.
+// Таблица только дополняется; изменения classroom_id в историю не попадают.
+// Время изменения - миллисекунды с начала эпохи Unix по часам SQLite.
+// Частичный индекс удалений позволяет inventoryAsOf не просматривать всю историю.
+const char* const kSchemaV2Sql = R"(
+    CREATE TABLE IF NOT EXISTS EquipmentHistory (
+        id INTEGER PRIMARY KEY AUTOINCREMENT,
+        inventory_number TEXT NOT NULL,  -- Инвентарный номер
+        ts INTEGER NOT NULL,             -- Время изменения, мс с начала эпохи Unix
+        op TEXT NOT NULL,                -- I - добавление, U - изменение, D - удаление
+        name TEXT NOT NULL,              -- Состояние записи после изменения
+        quantity INTEGER NOT NULL,       -- (для удаления - последнее состояние)
+        room TEXT NOT NULL,
+        responsible TEXT NOT NULL
+    );
+    CREATE INDEX IF NOT EXISTS idx_history_item_ts ON EquipmentHistory(inventory_number, ts);
+    CREATE INDEX IF NOT EXISTS idx_history_deleted ON EquipmentHistory(inventory_number) WHERE op = 'D';
+
+    CREATE TRIGGER IF NOT EXISTS trg_history_insert AFTER INSERT ON Equipment
+    WHEN NEW.inventory_number IS NOT NULL
+    BEGIN
+        INSERT INTO EquipmentHistory (inventory_number, ts, op, name, quantity, room, responsible)
+        VALUES (NEW.inventory_number, CAST((julianday('now') - 2440587.5) * 86400000 AS INTEGER),
+                'I', NEW.name, NEW.quantity, NEW.room, NEW.responsible);
+    END;
+
+    CREATE TRIGGER IF NOT EXISTS trg_history_update
+    AFTER UPDATE OF name, quantity, inventory_number, room, responsible ON Equipment
+    WHEN NEW.inventory_number IS NOT NULL AND (
+        OLD.name IS NOT NEW.name OR OLD.quantity IS NOT NEW.quantity OR
+        OLD.inventory_number IS NOT NEW.inventory_number OR
+        OLD.room IS NOT NEW.room OR OLD.responsible IS NOT NEW.responsible)
+    BEGIN
+        INSERT INTO EquipmentHistory (inventory_number, ts, op, name, quantity, room, responsible)
+        SELECT OLD.inventory_number, CAST((julianday('now') - 2440587.5) * 86400000 AS INTEGER),
+               'D', OLD.name, OLD.quantity, OLD.room, OLD.responsible
+        WHERE OLD.inventory_number IS NOT NEW.inventory_number AND OLD.inventory_number IS NOT NULL;
+        INSERT INTO EquipmentHistory (inventory_number, ts, op, name, quantity, room, responsible)
+        VALUES (NEW.inventory_number, CAST((julianday('now') - 2440587.5) * 86400000 AS INTEGER),
+                CASE WHEN OLD.inventory_number IS NEW.inventory_number THEN 'U' ELSE 'I' END,
+                NEW.name, NEW.quantity, NEW.room, NEW.responsible);
+    END;
+
+    CREATE TRIGGER IF NOT EXISTS trg_history_delete AFTER DELETE ON Equipment
+    WHEN OLD.inventory_number IS NOT NULL
+    BEGIN
+        INSERT INTO EquipmentHistory (inventory_number, ts, op, name, quantity, room, responsible)
+        VALUES (OLD.inventory_number, CAST((julianday('now') - 2440587.5) * 86400000 AS INTEGER),
+                'D', OLD.name, OLD.quantity, OLD.room, OLD.responsible);
+    END;
+
+    INSERT INTO EquipmentHistory (inventory_number, ts, op, name, quantity, room, responsible)
+    SELECT inventory_number, CAST((julianday('now') - 2440587.5) * 86400000 AS INTEGER), 'I', name, quantity, room, responsible
+    FROM Equipment WHERE inventory_number IS NOT NULL;
+)";
+
+// История одной единицы оборудования: поиск по индексу (inventory_number, ts)
+const char* const kSelectHistorySql =
+    "SELECT ts, op, name, quantity, room, responsible FROM EquipmentHistory "
+    "WHERE inventory_number = ? ORDER BY ts, id;";
+
+// Оборудование вместе с кабинетом; кабинета может не быть в Classrooms
+#define LOCATIONS_SELECT \
+    "SELECT e.id, e.inventory_number, e.quantity, e.room, e.responsible, e.classroom_id, " \
+    "c.building, c.floor, c.purpose FROM Equipment AS e LEFT JOIN Classrooms AS c ON c.id = e.classroom_id"
+
+const char* const kSelectLocationsSql = LOCATIONS_SELECT ";";
+const char* const kSelectLocationByIdSql = LOCATIONS_SELECT " WHERE e.id = ?;";
+const char* const kSelectLocationByClassroomSql = LOCATIONS_SELECT " WHERE e.classroom_id = ?;";
+
+#undef LOCATIONS_SELECT
+
+// Последняя запись истории номера k.inventory_number не позже ?1
+#define AS_OF_ENTRY \
+    "JOIN EquipmentHistory AS h ON h.id = (" \
+    "    SELECT id FROM EquipmentHistory WHERE inventory_number = k.inventory_number AND ts <= ?1 " \
+    "    ORDER BY ts DESC, id DESC LIMIT 1) "
+
+// Состав на момент времени. Номера берутся из Equipment и из удалений (частичный индекс
+// idx_history_deleted), а не из всей истории; для удаленных номеров учитывается одна,
+// последняя запись удаления. Обе части упорядочены индексами и сливаются без сортировки.
+const char* const kSelectAsOfSql =
+    "SELECT h.name, h.quantity, k.inventory_number, h.room, h.responsible "
+    "FROM Equipment AS k " AS_OF_ENTRY
+    "WHERE h.op <> 'D' "
+    "UNION ALL "
+    "SELECT h.name, h.quantity, k.inventory_number, h.room, h.responsible "
+    "FROM EquipmentHistory AS k " AS_OF_ENTRY
+    "WHERE k.op = 'D' AND h.op <> 'D' "
+    "AND k.id = (SELECT max(id) FROM EquipmentHistory WHERE inventory_number = k.inventory_number AND op = 'D') "
+    "AND NOT EXISTS (SELECT 1 FROM Equipment WHERE inventory_number = k.inventory_number) "
+    "ORDER BY 3;";
+
+#undef AS_OF_ENTRY
+
+// Канонический запрос Database в параметризованной форме
+struct CanonicalQuery {
+    const char* name; // Метод Database
+    const char* sql;  // Текст запроса
+};
+
+// Запросы, которые Database выполняет в рабочих путях; используются diagnoseQueries()
+const CanonicalQuery kCanonicalQueries[] = {
+    {"addEquipment", equipment::Insert::c_str},
+    {"updateEquipment", equipment::Update::c_str},
+    {"removeEquipment", equipment::Delete::c_str},
+    {"searchEquipment", equipment::Search::c_str},
+    {"getEquipment", equipment::SelectByInventory::c_str},
+    {"findEquipmentByLocation", equipment::SelectByLocation::c_str},
+    {"findEquipmentByPurpose", equipment::SelectByPurpose::c_str},
+    {"findEquipmentByResponsible", equipment::SelectByResponsible::c_str},
+    {"equipmentHistory", kSelectHistorySql},
+    {"inventoryAsOf", kSelectAsOfSql},
+    {"readEquipmentLocations", kSelectLocationByIdSql},
+    {"readClassroomEquipmentLocations", kSelectLocationByClassroomSql},
+};
+
+// Проверяет, описывает ли строка плана полный просмотр таблицы
+bool isFullScan(const std::string& detail) {
+    if (detail.compare(0, 5, "SCAN ") != 0) {
+        return false;
+    }
+    // Просмотр покрывающего индекса и константной строки полным сканированием таблицы не считаем
+    return detail.find(" INDEX ") == std::string::npos &&
+           detail.find("CONSTANT ROW") == std::string::npos;
+}
+
+// Временные триггеры подписки на изменения: передают кабинет до и после изменения строки.
+// sqlite3_update_hook сообщает только таблицу и rowid, а выполнять запросы из хука нельзя,
+// поэтому кабинет сохраняется функцией inventory_change_rooms в ходе самого изменения.
+const char* const kNotifyTriggersSql = R"(
+    CREATE TEMP TRIGGER IF NOT EXISTS trg_notify_equipment_insert AFTER INSERT ON main.Equipment
+    BEGIN SELECT inventory_change_rooms('Equipment', NEW.id, NULL, NEW.room); END;
+    CREATE TEMP TRIGGER IF NOT EXISTS trg_notify_equipment_update AFTER UPDATE ON main.Equipment
+    BEGIN SELECT inventory_change_rooms('Equipment', NEW.id, OLD.room, NEW.room); END;
+    CREATE TEMP TRIGGER IF NOT EXISTS trg_notify_equipment_delete AFTER DELETE ON main.Equipment
+    BEGIN SELECT inventory_change_rooms('Equipment', OLD.id, OLD.room, NULL); END;
+
+    CREATE TEMP TRIGGER IF NOT EXISTS trg_notify_classrooms_insert AFTER INSERT ON main.Classrooms
+    BEGIN SELECT inventory_change_rooms('Classrooms', NEW.id, NULL, NEW.room_number); END;
+    CREATE TEMP TRIGGER IF NOT EXISTS trg_notify_classrooms_update AFTER UPDATE ON main.Classrooms
+    BEGIN SELECT inventory_change_rooms('Classrooms', NEW.id, OLD.room_number, NEW.room_number); END;
+    CREATE TEMP TRIGGER IF NOT EXISTS trg_notify_classrooms_delete AFTER DELETE ON main.Classrooms
+    BEGIN SELECT inventory_change_rooms('Classrooms', OLD.id, OLD.room_number, NULL); END;
+)";
+
+} // namespace
 
 // Конструктор класса Database
 Database::Database(const std::string& db_path, Logger& logger)
@@ -14,12 +209,31 @@ Database::Database(const std::string& db_path, Logger& logger)
         throw std::runtime_error(err);
     }
 
+    // Несколько соединений с одним файлом (режим сервера) ждут снятия блокировки, а не падают с SQLITE_BUSY
+    sqlite3_busy_timeout(db, 5000);
+
+    // Нужно для ON DELETE SET NULL у Equipment.classroom_id
+    if (!execute("PRAGMA foreign_keys = ON;")) {
+        logger.log(Logger::WARNING, "Не удалось включить проверку внешних ключей");
+    }
+
     logger.log(Logger::INFO, "База данных успешно открыта");
 }
 
 // Деструктор класса Database
 Database::~Database() {
     if (db) {
+        for (auto& entry : statements) {
+            sqlite3_finalize(entry.second);
+        }
+        if (slow_log) {
+            sqlite3_trace_v2(db, 0, nullptr, nullptr);
+        }
+        if (notifier) {
+            sqlite3_update_hook(db, nullptr, nullptr);
+            sqlite3_commit_hook(db, nullptr, nullptr);
+            sqlite3_rollback_hook(db, nullptr, nullptr);
+        }
         sqlite3_close(db);
         logger.log(Logger::INFO, "Соединение с БД закрыто");
     }
@@ -29,14 +243,32 @@ Database::~Database() {
 bool Database::execute(const std::string& sql) {
     logger.log(Logger::INFO, "Выполнение SQL: " + sql);
 
-    char* errMsg = nullptr;
-    int result = sqlite3_exec(db, sql.c_str(), nullptr, nullptr, &errMsg);
+    // Выражения выполняются по одному: изменения выражения, зафиксированного в режиме
+    // autocommit, передаются подписчикам до того, как следующее выражение завершится ошибкой
+    const char* tail = sql.c_str();
+    while (*tail) {
+        sqlite3_stmt* stmt = nullptr;
+        int rc = sqlite3_prepare_v2(db, tail, -1, &stmt, &tail);
+        if (rc == SQLITE_OK && !stmt) {
+            continue; // Пробелы или комментарий в конце текста
+        }
 
-    if (result != SQLITE_OK) {
-        std::string err = "Ошибка SQL: " + std::string(errMsg);
-        logger.log(Logger::ERROR, err);
-        sqlite3_free(errMsg);
-        return false;
+        if (rc == SQLITE_OK) {
+            while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+            }
+        }
+
+        if (rc != SQLITE_OK && rc != SQLITE_DONE) {
+            logger.log(Logger::ERROR, "Ошибка SQL: " + std::string(sqlite3_errmsg(db)));
+            sqlite3_finalize(stmt);
+            flushSlowQueries();
+            settleChanges();
+            return false;
+        }
+
+        sqlite3_finalize(stmt);
+        flushSlowQueries();
+        settleChanges();
     }
 
     logger.log(Logger::INFO, "SQL выполнен успешно");
@@ -50,18 +282,7 @@ bool Database::initialize() {
     if (!tableExists("Equipment")) {
         logger.log(Logger::WARNING, "Таблица Equipment не найдена, создаем...");
 
-        std::string sql = R"(
-            CREATE TABLE Equipment (
-                id INTEGER PRIMARY KEY AUTOINCREMENT,
-                name TEXT NOT NULL,              -- Наименование оборудования
-                quantity INTEGER NOT NULL,       -- Количество
-                inventory_number TEXT UNIQUE,    -- Инвентарный номер (уникальный)
-                room TEXT NOT NULL,              -- Кабинет/помещение
-                responsible TEXT NOT NULL        -- МОЛ (Материально ответственное лицо)
-            );
-        )";
-
-        if (!execute(sql)) {
+        if (!execute(equipment::CreateTable::c_str)) {
             logger.log(Logger::ERROR, "Ошибка создания таблицы Equipment");
             return false;
         }
@@ -70,18 +291,7 @@ bool Database::initialize() {
     if (!tableExists("Classrooms")) {
         logger.log(Logger::WARNING, "Таблица Classrooms не найдена, создаем...");
 
-        std::string sql = R"(
-            CREATE TABLE Classrooms (
-                id INTEGER PRIMARY KEY AUTOINCREMENT,
-                room_number TEXT NOT NULL UNIQUE, -- Номер кабинета (уникальный)
-                building TEXT NOT NULL,           -- Корпус (А, Б1, Б2)
-                floor INTEGER NOT NULL,           -- Этаж
-                purpose TEXT,                    -- Назначение (история, математика и т.д.)
-                responsible TEXT                 -- Ответственный за кабинет
-            );
-        )";
-
-        if (!execute(sql)) {
+        if (!execute(classrooms::CreateTable::c_str)) {
             logger.log(Logger::ERROR, "Ошибка создания таблицы Classrooms");
             return false;
         }
@@ -123,27 +333,68 @@ bool Database::initialize() {
         }
     }
 
+    if (!migrate()) {
+        logger.log(Logger::ERROR, "Ошибка миграции схемы БД");
+        return false;
+    }
+
     logger.log(Logger::INFO, "Структура БД успешно инициализирована");
     return true;
 }
 
-// Метод для проверки существования таблицы
-bool Database::tableExists(const std::string& tableName) {
-    std::string sql = "SELECT count(*) FROM sqlite_master WHERE type='table' AND name='" + tableName + "';";
-    sqlite3_stmt* stmt;
+// Метод для применения миграций схемы
+bool Database::migrate() {
+    return applyMigration(1, "индексы и связь Equipment.classroom_id -> Classrooms.id", [this] {
+        if (!columnExists("Equipment", "classroom_id") &&
+            !execute("ALTER TABLE Equipment ADD COLUMN " + std::string(equipment::ClassroomId::name) + " " +
+                     std::string(equipment::ClassroomId::definition) + ";")) {
+            return false;
+        }
+        return execute(kSchemaV1Sql);
+    }) && applyMigration(2, "история перемещений оборудования EquipmentHistory", [this] {
+        return execute(kSchemaV2Sql);
+    });
+}
 
-    if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
-        std::string err = "Ошибка подготовки запроса: " + std::string(sqlite3_errmsg(db));
-        logger.log(Logger::ERROR, err);
+// Метод для применения одной миграции схемы
+bool Database::applyMigration(int version, const std::string& description,
+                              const std::function<bool()>& steps) {
+    auto rows = queryRows("PRAGMA user_version;", nullptr);
+    int current = rows.empty() ? 0 : std::stoi(rows[0][0]);
+    if (current >= version) {
+        return true;
+    }
+
+    logger.log(Logger::INFO, "Миграция схемы до версии " + std::to_string(version) + ": " + description);
+
+    if (!execute("BEGIN;")) {
         return false;
     }
 
-    bool exists = false;
-    if (sqlite3_step(stmt) == SQLITE_ROW) {
-        exists = (sqlite3_column_int(stmt, 0) == 1);
+    if (!steps() || !execute("PRAGMA user_version = " + std::to_string(version) + ";")) {
+        execute("ROLLBACK;");
+        return false;
     }
 
-    sqlite3_finalize(stmt);
+    return execute("COMMIT;");
+}
+
+// Метод для проверки существования столбца
+bool Database::columnExists(const std::string& tableName, const std::string& column) {
+    auto rows = queryRows("SELECT count(*) FROM pragma_table_info(?) WHERE name = ?;", [&](sqlite3_stmt* stmt) {
+        return sqlite3_bind_text(stmt, 1, tableName.c_str(), -1, SQLITE_TRANSIENT) == SQLITE_OK &&
+               sqlite3_bind_text(stmt, 2, column.c_str(), -1, SQLITE_TRANSIENT) == SQLITE_OK;
+    });
+    return !rows.empty() && rows[0][0] != "0";
+}
+
+// Метод для проверки существования таблицы
+bool Database::tableExists(const std::string& tableName) {
+    auto rows = queryRows("SELECT count(*) FROM sqlite_master WHERE type = 'table' AND name = ?;",
+                          [&](sqlite3_stmt* stmt) {
+        return sqlite3_bind_text(stmt, 1, tableName.c_str(), -1, SQLITE_TRANSIENT) == SQLITE_OK;
+    });
+    bool exists = !rows.empty() && rows[0][0] == "1";
 
     if (exists) {
         logger.log(Logger::INFO, "Таблица существует: " + tableName);
@@ -176,59 +427,643 @@ bool Database::addEquipment(const std::string& name, int quantity,
                             const std::string& inventory_number,
                             const std::string& room,
                             const std::string& responsible) {
-    std::string sql = "INSERT INTO Equipment (name, quantity, inventory_number, room, responsible) "
-                      "VALUES ('" + name + "', " + std::to_string(quantity) + ", '" +
-                      inventory_number + "', '" + room + "', '" + responsible + "');";
+    logger.log(Logger::INFO, "Добавление оборудования: " + inventory_number);
+    if (recorder) {
+        recorder->record(trace::Op::Add, {name, std::to_string(quantity), inventory_number, room, responsible});
+    }
 
-    return execute(sql);
+    sqlite3_stmt* stmt = prepared(equipment::Insert::c_str);
+    return stmt && runStatement(stmt, schema::bind<equipment::Insert>(stmt, name, quantity, inventory_number,
+                                                                      room, responsible));
 }
 
 // Метод для обновления данных об оборудовании
 bool Database::updateEquipment(const std::string& inventory_number, int new_quantity,
                                const std::string& new_room,
                                const std::string& new_responsible) {
-    std::string sql = "UPDATE Equipment SET "
-                      "quantity = " + std::to_string(new_quantity) + ", "
-                      "room = '" + new_room + "', "
-                      "responsible = '" + new_responsible + "' "
-                      "WHERE inventory_number = '" + inventory_number + "';";
+    logger.log(Logger::INFO, "Обновление оборудования: " + inventory_number);
+    if (recorder) {
+        recorder->record(trace::Op::Update, {inventory_number, std::to_string(new_quantity), new_room, new_responsible});
+    }
 
-    return execute(sql);
+    sqlite3_stmt* stmt = prepared(equipment::Update::c_str);
+    return stmt && runStatement(stmt, schema::bind<equipment::Update>(stmt, new_quantity, new_room,
+                                                                      new_responsible, inventory_number));
 }
 
 // Метод для удаления оборудования
 bool Database::removeEquipment(const std::string& inventory_number) {
-    std::string sql = "DELETE FROM Equipment WHERE inventory_number = '" + inventory_number + "';";
-    return execute(sql);
+    logger.log(Logger::INFO, "Удаление оборудования: " + inventory_number);
+    if (recorder) {
+        recorder->record(trace::Op::Remove, {inventory_number});
+    }
+
+    sqlite3_stmt* stmt = prepared(equipment::Delete::c_str);
+    return stmt && runStatement(stmt, schema::bind<equipment::Delete>(stmt, inventory_number));
 }
 
 // Метод для поиска оборудования
 std::vector<std::vector<std::string>> Database::searchEquipment(const std::string& query) {
-    std::vector<std::vector<std::string>> results;
+    if (recorder) {
+        recorder->record(trace::Op::Search, {query});
+    }
+    std::string pattern = "%" + query + "%";
+    auto results = queryRows(equipment::Search::c_str, [&](sqlite3_stmt* stmt) {
+        return schema::bind<equipment::Search>(stmt, pattern);
+    });
+    logger.log(Logger::INFO, "Найдено записей оборудования: " + std::to_string(results.size()));
+    return results;
+}
+
+// Метод для поиска оборудования с типизированным результатом
+std::vector<EquipmentRecord> Database::searchEquipmentRecords(const std::string& query) {
+    if (recorder) {
+        recorder->record(trace::Op::Search, {query});
+    }
+    std::vector<EquipmentRecord> results;
+
+    sqlite3_stmt* stmt = prepared(equipment::Search::c_str);
+    if (!stmt) {
+        return results;
+    }
+
+    std::string pattern = "%" + query + "%";
+    if (schema::bind<equipment::Search>(stmt, pattern)) {
+        while (sqlite3_step(stmt) == SQLITE_ROW) {
+            results.push_back(schema::extract<equipment::Search, EquipmentRecord>(stmt));
+        }
+    }
+
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+    flushSlowQueries();
+    settleChanges();
+    logger.log(Logger::INFO, "Найдено записей оборудования: " + std::to_string(results.size()));
+    return results;
+}
+
+// Метод для получения оборудования по инвентарному номеру
+std::vector<std::string> Database::getEquipment(const std::string& inventory_number) {
+    if (recorder) {
+        recorder->record(trace::Op::Get, {inventory_number});
+    }
+    auto results = queryRows(equipment::SelectByInventory::c_str, [&](sqlite3_stmt* stmt) {
+        return schema::bind<equipment::SelectByInventory>(stmt, inventory_number);
+    });
+    return results.empty() ? std::vector<std::string>() : std::move(results[0]);
+}
+
+// Метод для поиска оборудования по этажу корпуса
+std::vector<std::vector<std::string>> Database::findEquipmentByLocation(const std::string& building, int floor) {
+    auto results = queryRows(equipment::SelectByLocation::c_str, [&](sqlite3_stmt* stmt) {
+        return schema::bind<equipment::SelectByLocation>(stmt, building, floor);
+    });
+    logger.log(Logger::INFO, "Найдено оборудования в корпусе " + building + ", этаж " +
+                             std::to_string(floor) + ": " + std::to_string(results.size()));
+    return results;
+}
+
+// Метод для поиска оборудования по назначению кабинета
+std::vector<std::vector<std::string>> Database::findEquipmentByPurpose(const std::string& purpose) {
+    auto results = queryRows(equipment::SelectByPurpose::c_str, [&](sqlite3_stmt* stmt) {
+        return schema::bind<equipment::SelectByPurpose>(stmt, purpose);
+    });
+    logger.log(Logger::INFO, "Найдено оборудования в кабинетах \"" + purpose + "\": " +
+                             std::to_string(results.size()));
+    return results;
+}
 
-    std::string sql = "SELECT name, quantity, inventory_number, room, responsible "
-                      "FROM Equipment WHERE name LIKE '%" + query + "%' OR room LIKE '%" + query + "%';";
+// Метод для поиска оборудования по ответственному
+std::vector<std::vector<std::string>> Database::findEquipmentByResponsible(const std::string& responsible) {
+    auto results = queryRows(equipment::SelectByResponsible::c_str, [&](sqlite3_stmt* stmt) {
+        return schema::bind<equipment::SelectByResponsible>(stmt, responsible);
+    });
+    logger.log(Logger::INFO, "Найдено оборудования за " + responsible + ": " + std::to_string(results.size()));
+    return results;
+}
+
+// Метод для получения истории изменений оборудования
+std::vector<std::vector<std::string>> Database::equipmentHistory(const std::string& inventory_number) {
+    auto results = queryRows(kSelectHistorySql, [&](sqlite3_stmt* stmt) {
+        return sqlite3_bind_text(stmt, 1, inventory_number.c_str(), -1, SQLITE_TRANSIENT) == SQLITE_OK;
+    });
+    logger.log(Logger::INFO, "Записей истории для " + inventory_number + ": " + std::to_string(results.size()));
+    return results;
+}
+
+// Метод для восстановления состава оборудования на момент времени
+std::vector<std::vector<std::string>> Database::inventoryAsOf(std::int64_t ts) {
+    auto results = queryRows(kSelectAsOfSql, [&](sqlite3_stmt* stmt) {
+        return sqlite3_bind_int64(stmt, 1, ts) == SQLITE_OK;
+    });
+    logger.log(Logger::INFO, "Записей оборудования на момент " + std::to_string(ts) + ": " +
+                             std::to_string(results.size()));
+    return results;
+}
+
+// Метод для фиксации времени записей истории
+bool Database::setHistoryTime(std::optional<std::int64_t> ts) {
+    // Временный триггер виден только этому соединению и исчезает при его закрытии
+    std::string sql = "DROP TRIGGER IF EXISTS temp.trg_history_clock;";
+    if (ts) {
+        sql += "CREATE TEMP TRIGGER trg_history_clock AFTER INSERT ON main.EquipmentHistory "
+               "BEGIN UPDATE EquipmentHistory SET ts = " + std::to_string(*ts) + " WHERE id = NEW.id; END;";
+    }
+
+    if (!execute(sql)) {
+        logger.log(Logger::ERROR, "Не удалось установить время истории");
+        return false;
+    }
+
+    logger.log(Logger::INFO, ts ? "Время истории зафиксировано: " + std::to_string(*ts)
+                                : std::string("Время истории: текущее"));
+    return true;
+}
+
+// Метод для сжатия истории изменений
+long long Database::compactHistory(std::int64_t before, const std::string& archive_path) {
+    logger.log(Logger::INFO, "Сжатие истории до момента " + std::to_string(before) +
+                             (archive_path.empty() ? std::string(" без архива") : ", архив: " + archive_path));
+
+    // ATTACH нельзя выполнить внутри транзакции
+    if (!archive_path.empty()) {
+        sqlite3_stmt* stmt;
+        if (sqlite3_prepare_v2(db, "ATTACH DATABASE ? AS history_archive;", -1, &stmt, nullptr) != SQLITE_OK) {
+            logger.log(Logger::ERROR, "Ошибка подготовки запроса: " + std::string(sqlite3_errmsg(db)));
+            return -1;
+        }
+        sqlite3_bind_text(stmt, 1, archive_path.c_str(), -1, SQLITE_TRANSIENT);
+        int rc = sqlite3_step(stmt);
+        sqlite3_finalize(stmt);
+        if (rc != SQLITE_DONE) {
+            logger.log(Logger::ERROR, "Не удалось подключить архив истории: " + std::string(sqlite3_errmsg(db)));
+            return -1;
+        }
+    }
+
+    // Остается последняя запись до границы для каждого номера, если она не удаление
+    std::string cutoff = std::to_string(before);
+    std::string selectSql =
+        "CREATE TEMP TABLE history_compact AS "
+        "SELECT h.id FROM EquipmentHistory AS h WHERE h.ts < " + cutoff + " AND NOT (h.op <> 'D' AND h.id = ("
+        "    SELECT id FROM EquipmentHistory WHERE inventory_number = h.inventory_number AND ts < " + cutoff +
+        "    ORDER BY ts DESC, id DESC LIMIT 1));";
+
+    std::string archiveSql = archive_path.empty() ? std::string() :
+        "CREATE TABLE IF NOT EXISTS history_archive.EquipmentHistory ("
+        "    id INTEGER PRIMARY KEY, inventory_number TEXT NOT NULL, ts INTEGER NOT NULL, op TEXT NOT NULL,"
+        "    name TEXT NOT NULL, quantity INTEGER NOT NULL, room TEXT NOT NULL, responsible TEXT NOT NULL);"
+        "INSERT OR IGNORE INTO history_archive.EquipmentHistory "
+        "SELECT * FROM main.EquipmentHistory WHERE id IN (SELECT id FROM temp.history_compact);";
+
+    long long archived = -1;
+    if (execute("BEGIN;")) {
+        std::vector<std::vector<std::string>> counted;
+        bool ok = execute(selectSql) && (archiveSql.empty() || execute(archiveSql)) &&
+                  execute("DELETE FROM main.EquipmentHistory WHERE id IN (SELECT id FROM temp.history_compact);");
+        if (ok) {
+            counted = queryRows("SELECT count(*) FROM temp.history_compact;", nullptr);
+            ok = !counted.empty() && execute("DROP TABLE temp.history_compact;") && execute("COMMIT;");
+        }
+        if (ok) {
+            archived = std::stoll(counted[0][0]);
+        } else {
+            execute("ROLLBACK;");
+        }
+    }
+
+    if (!archive_path.empty()) {
+        execute("DETACH DATABASE history_archive;");
+    }
+
+    if (archived < 0) {
+        logger.log(Logger::ERROR, "Ошибка сжатия истории");
+    } else {
+        logger.log(Logger::INFO, "Перенесено записей истории: " + std::to_string(archived));
+    }
+    return archived;
+}
+
+// Метод для получения подготовленного выражения из кэша
+sqlite3_stmt* Database::prepared(const char* sql) {
+    auto it = statements.find(sql);
+    if (it != statements.end()) {
+        return it->second;
+    }
 
     sqlite3_stmt* stmt;
-    if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+    if (sqlite3_prepare_v3(db, sql, -1, SQLITE_PREPARE_PERSISTENT, &stmt, nullptr) != SQLITE_OK) {
         std::string err = "Ошибка подготовки запроса: " + std::string(sqlite3_errmsg(db));
         logger.log(Logger::ERROR, err);
+        return nullptr;
+    }
+
+    statements.emplace(sql, stmt);
+    return stmt;
+}
+
+// Метод для выполнения подготовленного выражения без результата
+bool Database::runStatement(sqlite3_stmt* stmt, bool bound) {
+    int rc = bound ? sqlite3_step(stmt) : SQLITE_RANGE;
+    if (rc != SQLITE_DONE) {
+        logger.log(Logger::ERROR, "Ошибка SQL: " + std::string(bound ? sqlite3_errmsg(db) : "ошибка привязки параметров"));
+    }
+
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+    flushSlowQueries();
+    settleChanges();
+    return rc == SQLITE_DONE;
+}
+
+// Метод для выполнения подготовленного запроса
+std::vector<std::vector<std::string>> Database::queryRows(const char* sql,
+                                                          const std::function<bool(sqlite3_stmt*)>& bind) {
+    std::vector<std::vector<std::string>> results;
+
+    sqlite3_stmt* stmt = prepared(sql);
+    if (!stmt) {
         return results;
     }
 
-    while (sqlite3_step(stmt) == SQLITE_ROW) {
+    if (bind && !bind(stmt)) {
+        logger.log(Logger::ERROR, "Ошибка привязки параметров запроса: " + std::string(sqlite3_errmsg(db)));
+        sqlite3_reset(stmt);
+        sqlite3_clear_bindings(stmt);
+        return results;
+    }
+
+    int colCount = sqlite3_column_count(stmt);
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
         std::vector<std::string> row;
-        int colCount = sqlite3_column_count(stmt);
+        row.reserve(colCount);
 
         for (int i = 0; i < colCount; ++i) {
             const char* colText = reinterpret_cast<const char*>(sqlite3_column_text(stmt, i));
             row.push_back(colText ? colText : "");
         }
 
-        results.push_back(row);
+        results.push_back(std::move(row));
     }
 
-    sqlite3_finalize(stmt);
-    logger.log(Logger::INFO, "Найдено записей оборудования: " + std::to_string(results.size()));
+    if (rc != SQLITE_DONE) {
+        logger.log(Logger::ERROR, "Ошибка выполнения запроса: " + std::string(sqlite3_errmsg(db)));
+    }
+
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+    flushSlowQueries();
+    settleChanges();
     return results;
-}
\ No newline at end of file
+}
+
+// Метод для включения журнала медленных запросов
+bool Database::enableProfiling(const std::string& slow_log_path, std::chrono::microseconds threshold) {
+    if (!enableProfiling(std::make_shared<Logger>(slow_log_path), threshold)) {
+        return false;
+    }
+
+    logger.log(Logger::INFO, "Профилирование запросов включено, журнал: " + slow_log_path +
+                             ", порог: " + std::to_string(threshold.count()) + " мкс");
+    return true;
+}
+
+// Метод для включения журнала медленных запросов, общего для нескольких соединений
+bool Database::enableProfiling(std::shared_ptr<Logger> log, std::chrono::microseconds threshold) {
+    slow_log = std::move(log);
+    slow_threshold = threshold;
+    rows_stepped.clear();
+    slow_queries.clear();
+
+    if (sqlite3_trace_v2(db, SQLITE_TRACE_PROFILE | SQLITE_TRACE_ROW, &Database::traceCallback, this) != SQLITE_OK) {
+        logger.log(Logger::ERROR, "Не удалось включить профилирование: " + std::string(sqlite3_errmsg(db)));
+        slow_log.reset();
+        return false;
+    }
+    return true;
+}
+
+// Метод для выключения журнала медленных запросов
+void Database::disableProfiling() {
+    if (!slow_log) {
+        return;
+    }
+
+    // Накопленные запросы записываются, пока журнал еще открыт
+    flushSlowQueries();
+    sqlite3_trace_v2(db, 0, nullptr, nullptr);
+    slow_log.reset();
+    slow_queries.clear();
+    rows_stepped.clear();
+    logger.log(Logger::INFO, "Профилирование запросов выключено");
+}
+
+// Обработчик событий трассировки SQLite
+int Database::traceCallback(unsigned type, void* context, void* p, void* x) {
+    auto* self = static_cast<Database*>(context);
+    auto* stmt = static_cast<sqlite3_stmt*>(p);
+
+    // Планы запросов (flushSlowQueries, diagnoseQueries) сами в журнал не попадают
+    if (sqlite3_stmt_isexplain(stmt)) {
+        return 0;
+    }
+
+    if (type == SQLITE_TRACE_ROW) {
+        ++self->rows_stepped[stmt];
+        return 0;
+    }
+
+    if (type != SQLITE_TRACE_PROFILE) {
+        return 0;
+    }
+
+    std::int64_t rows = 0;
+    auto it = self->rows_stepped.find(stmt);
+    if (it != self->rows_stepped.end()) {
+        rows = it->second;
+        self->rows_stepped.erase(it);
+    }
+
+    std::int64_t elapsed_ns = *static_cast<sqlite3_int64*>(x);
+    if (elapsed_ns < self->slow_threshold.count()) {
+        return 0;
+    }
+
+    // План строится позже, в flushSlowQueries: из обработчика трассировки
+    // нельзя выполнять другие запросы на том же соединении
+    SlowQuery entry;
+    char* expanded = sqlite3_expanded_sql(stmt);
+    entry.sql = expanded ? expanded : sqlite3_sql(stmt);
+    sqlite3_free(expanded);
+    entry.elapsed_ns = elapsed_ns;
+    entry.rows = rows;
+    entry.fullscan_steps = sqlite3_stmt_status(stmt, SQLITE_STMTSTATUS_FULLSCAN_STEP, 0);
+    self->slow_queries.push_back(std::move(entry));
+    return 0;
+}
+
+// Метод для записи накопленных медленных запросов в журнал
+void Database::flushSlowQueries() {
+    if (!slow_log || slow_queries.empty()) {
+        return;
+    }
+
+    std::vector<SlowQuery> pending;
+    pending.swap(slow_queries);
+
+    for (const auto& entry : pending) {
+        std::ostringstream message;
+        message << "Медленный запрос: " << std::fixed << std::setprecision(3)
+                << static_cast<double>(entry.elapsed_ns) / 1e6 << " мс, строк: " << entry.rows
+                << ", шагов полного просмотра: " << entry.fullscan_steps << ", SQL: " << entry.sql;
+        slow_log->log(Logger::INFO, message.str());
+
+        for (const auto& line : explainQueryPlan(entry.sql)) {
+            slow_log->log(Logger::INFO, "    " + line);
+        }
+    }
+}
+
+// Метод для получения плана запроса
+std::vector<std::string> Database::explainQueryPlan(const std::string& sql) {
+    std::vector<std::string> plan;
+    std::string explainSql = "EXPLAIN QUERY PLAN " + sql;
+
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(db, explainSql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+        logger.log(Logger::WARNING, "Не удалось построить план запроса: " + std::string(sqlite3_errmsg(db)));
+        return plan;
+    }
+
+    // Столбцы EXPLAIN QUERY PLAN: id, parent, notused, detail
+    std::map<int, int> depth;
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        int id = sqlite3_column_int(stmt, 0);
+        int parent = sqlite3_column_int(stmt, 1);
+        const char* detail = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 3));
+
+        int level = depth.count(parent) ? depth[parent] + 1 : 0;
+        depth[id] = level;
+        plan.push_back(std::string(level * 2, ' ') + (detail ? detail : ""));
+    }
+
+    sqlite3_finalize(stmt);
+    return plan;
+}
+
+// Метод для диагностики планов канонических запросов
+std::vector<Database::QueryDiagnostic> Database::diagnoseQueries() {
+    std::vector<QueryDiagnostic> report;
+
+    for (const auto& query : kCanonicalQueries) {
+        QueryDiagnostic diagnostic{query.name, query.sql, explainQueryPlan(query.sql), false};
+
+        for (const auto& line : diagnostic.plan) {
+            std::size_t start = line.find_first_not_of(' ');
+            std::string detail = start == std::string::npos ? std::string() : line.substr(start);
+            if (isFullScan(detail)) {
+                diagnostic.full_scan = true;
+                logger.log(Logger::INFO, "Полный просмотр таблицы в запросе " + diagnostic.name + ": " + detail);
+            }
+        }
+
+        report.push_back(std::move(diagnostic));
+    }
+
+    return report;
+}
+
+// Метод для подписки на изменения таблицы
+int Database::subscribe(const std::string& table, ChangeNotifier::Callback callback, const std::string& room) {
+    if (!notifier && !enableNotifications()) {
+        return -1;
+    }
+    return notifier->subscribe(table, room, std::move(callback));
+}
+
+// Метод для отмены подписки на изменения
+void Database::unsubscribe(int id) {
+    if (notifier) {
+        notifier->unsubscribe(id);
+    }
+}
+
+// Метод для ожидания доставки изменений
+void Database::waitForNotifications() {
+    if (notifier) {
+        notifier->waitIdle();
+    }
+}
+
+// Метод для передачи подписчикам изменений завершенной транзакции
+void Database::settleChanges() {
+    // Соединение вернулось в режим autocommit - транзакция зафиксирована или отменена
+    if (notifier) {
+        notifier->settle(sqlite3_get_autocommit(db) != 0);
+    }
+}
+
+// Метод для включения рассылки изменений
+bool Database::enableNotifications() {
+    if (sqlite3_create_function(db, "inventory_change_rooms", 4, SQLITE_UTF8, this,
+                                &Database::changeRoomsFunction, nullptr, nullptr) != SQLITE_OK) {
+        logger.log(Logger::ERROR, "Не удалось зарегистрировать функцию подписки: " + std::string(sqlite3_errmsg(db)));
+        return false;
+    }
+
+    if (!execute(kNotifyTriggersSql)) {
+        logger.log(Logger::ERROR, "Не удалось создать триггеры подписки на изменения");
+        return false;
+    }
+
+    notifier = std::make_unique<ChangeNotifier>(logger);
+    sqlite3_update_hook(db, &Database::updateHook, this);
+    sqlite3_commit_hook(db, &Database::commitHook, this);
+    sqlite3_rollback_hook(db, &Database::rollbackHook, this);
+
+    logger.log(Logger::INFO, "Рассылка изменений включена");
+    return true;
+}
+
+// Обработчик изменения строки
+void Database::updateHook(void* context, int operation, const char* database, const char* table,
+                          sqlite3_int64 rowid) {
+    // Временные таблицы и подключенные архивы (compactHistory) подписчикам не нужны
+    if (std::strcmp(database, "main") != 0) {
+        return;
+    }
+    static_cast<Database*>(context)->notifier->recordChange(operation, table, rowid);
+}
+
+// Обработчик начала фиксации транзакции; COMMIT еще может завершиться ошибкой
+int Database::commitHook(void* context) {
+    static_cast<Database*>(context)->notifier->commit();
+    return 0; // Ненулевое значение превратило бы фиксацию в откат
+}
+
+// Обработчик отката транзакции
+void Database::rollbackHook(void* context) {
+    static_cast<Database*>(context)->notifier->rollback();
+}
+
+// SQL-функция, сохраняющая кабинет строки до и после изменения
+void Database::changeRoomsFunction(sqlite3_context* context, int, sqlite3_value** argv) {
+    auto* self = static_cast<Database*>(sqlite3_user_data(context));
+    if (self->notifier) {
+        self->notifier->recordRooms(reinterpret_cast<const char*>(sqlite3_value_text(argv[0])),
+                                    sqlite3_value_int64(argv[1]),
+                                    reinterpret_cast<const char*>(sqlite3_value_text(argv[2])),
+                                    reinterpret_cast<const char*>(sqlite3_value_text(argv[3])));
+    }
+    sqlite3_result_null(context);
+}
+
+// Метод для включения записи трассы вызовов в файл
+bool Database::startRecording(const std::string& trace_path) {
+    std::string snapshot = trace::snapshotPath(trace_path);
+    std::remove(snapshot.c_str());
+    if (!backupTo(snapshot)) {
+        logger.log(Logger::ERROR, "Не удалось снять копию БД для трассы: " + snapshot);
+        return false;
+    }
+
+    auto writer = std::make_shared<trace::Writer>();
+    if (!writer->open(trace_path)) {
+        logger.log(Logger::ERROR, "Не удалось создать файл трассы: " + trace_path);
+        return false;
+    }
+    startRecording(writer);
+    logger.log(Logger::INFO, "Запись трассы вызовов: " + trace_path);
+    return true;
+}
+
+// Метод для включения записи трассы вызовов в общий файл
+void Database::startRecording(std::shared_ptr<trace::Writer> writer) {
+    recorder = std::move(writer);
+}
+
+// Метод для выключения записи трассы вызовов
+void Database::stopRecording() {
+    if (recorder) {
+        // Файл закрывается, когда его не использует ни одно соединение
+        recorder.reset();
+        logger.log(Logger::INFO, "Запись трассы вызовов остановлена");
+    }
+}
+
+// Метод для создания копии БД
+bool Database::backupTo(const std::string& path) {
+    logger.log(Logger::INFO, "Копия БД: " + path);
+
+    sqlite3_stmt* stmt = prepared("VACUUM INTO ?;");
+    return stmt && runStatement(stmt, sqlite3_bind_text(stmt, 1, path.c_str(), -1, SQLITE_TRANSIENT) == SQLITE_OK);
+}
+
+// Метод для чтения всего оборудования вместе с кабинетами
+bool Database::readEquipmentLocations(const std::function<void(const EquipmentLocationRecord&)>& sink) {
+    sqlite3_stmt* stmt = prepared(kSelectLocationsSql);
+    return stmt && stepLocations(stmt, sink);
+}
+
+// Метод для чтения оборудования с заданными id вместе с кабинетами
+bool Database::readEquipmentLocations(const std::vector<std::int64_t>& ids,
+                                      const std::function<void(const EquipmentLocationRecord&)>& sink) {
+    sqlite3_stmt* stmt = prepared(kSelectLocationByIdSql);
+    if (!stmt) {
+        return false;
+    }
+
+    for (std::int64_t id : ids) {
+        if (schema::Binder<std::int64_t>::bind(stmt, 1, id) != SQLITE_OK || !stepLocations(stmt, sink)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Метод для чтения оборудования кабинетов вместе с данными кабинета
+bool Database::readClassroomEquipmentLocations(const std::vector<std::int64_t>& classroom_ids,
+                                               const std::function<void(const EquipmentLocationRecord&)>& sink) {
+    sqlite3_stmt* stmt = prepared(kSelectLocationByClassroomSql);
+    if (!stmt) {
+        return false;
+    }
+
+    for (std::int64_t id : classroom_ids) {
+        if (schema::Binder<std::int64_t>::bind(stmt, 1, id) != SQLITE_OK || !stepLocations(stmt, sink)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Метод для выполнения запроса оборудования с кабинетами
+bool Database::stepLocations(sqlite3_stmt* stmt, const std::function<void(const EquipmentLocationRecord&)>& sink) {
+    using schema::Binder;
+
+    EquipmentLocationRecord record;
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+        record.id = Binder<std::int64_t>::extract(stmt, 0);
+        record.inventory_number = Binder<std::string>::extract(stmt, 1);
+        record.quantity = Binder<int>::extract(stmt, 2);
+        record.room = Binder<std::string>::extract(stmt, 3);
+        record.responsible = Binder<std::string>::extract(stmt, 4);
+        record.classroom_id = Binder<std::optional<std::int64_t>>::extract(stmt, 5);
+        record.building = Binder<std::optional<std::string>>::extract(stmt, 6);
+        record.floor = Binder<std::optional<int>>::extract(stmt, 7);
+        record.purpose = Binder<std::optional<std::string>>::extract(stmt, 8);
+        sink(record);
+    }
+
+    if (rc != SQLITE_DONE) {
+        logger.log(Logger::ERROR, "Ошибка чтения оборудования: " + std::string(sqlite3_errmsg(db)));
+    }
+
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+    flushSlowQueries();
+    settleChanges();
+    return rc == SQLITE_DONE;
+}
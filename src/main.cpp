@@ -1,8 +1,27 @@
 #include <iostream> // Для работы с вводом/выводом
+#include <algorithm> // Для std::max
+#include <chrono>   // Для порога медленных запросов
+#include <optional> // Для необязательного порога профилирования
+#include <string>   // Для разбора аргументов командной строки
 #include "../include/database.hpp" // Подключаем класс Database
 #include "../include/Logger.hpp"   // Подключаем класс Logger
+#ifdef INVENTORY_WITH_SERVER
+#include <csignal>                  // Для остановки сервера по сигналу
+#include <thread>                   // Для числа рабочих потоков по умолчанию
+#include "../include/DatabasePool.hpp" // Подключаем пул соединений
+#include "../include/Server.hpp"       // Подключаем сетевой сервер
 
-int main() {
+// Сервер, который останавливается по SIGINT/SIGTERM
+static Server* runningServer = nullptr;
+
+static void stopServer(int) {
+    if (runningServer) {
+        runningServer->stop();
+    }
+}
+#endif
+
+int main(int argc, char* argv[]) {
     // Создаем объект логгера для записи событий в файл school_inventory.log
     Logger logger("school_inventory.log");
 
@@ -16,6 +35,115 @@ int main() {
             return 1; // Завершаем программу с кодом ошибки
         }
 
+        // Разбор аргументов командной строки:
+        //   --diagnose        - вывести планы канонических запросов и выйти
+        //   --profile <мс>    - писать запросы дольше порога в slow_queries.log
+        //   --compact-history <дней> [архив.db] - перенести историю старше N дней в архив и выйти
+        //   --serve <порт|путь> - работать как сервер на 127.0.0.1:порт или Unix-сокете
+        //   --workers <N>     - число рабочих потоков и соединений с БД в режиме сервера
+        //   --record <файл>   - записывать трассу вызовов для inventory_replay
+        bool diagnose = false;
+        std::string serveAddress;
+        std::string tracePath;
+        std::optional<std::chrono::milliseconds> profileThreshold;
+        unsigned workers = 0;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool needsValue = arg == "--profile" || arg == "--compact-history" || arg == "--serve" ||
+                              arg == "--workers" || arg == "--record";
+            if (needsValue && i + 1 >= argc) {
+                std::cerr << "Не указано значение аргумента " << arg << "\n";
+                return 1;
+            }
+
+            if (arg == "--diagnose") {
+                diagnose = true;
+            } else if (arg == "--profile" && i + 1 < argc) {
+                profileThreshold = std::chrono::milliseconds(std::stoll(argv[++i]));
+                if (!db.enableProfiling("slow_queries.log", *profileThreshold)) {
+                    std::cerr << "Не удалось включить профилирование запросов.\n";
+                    return 1;
+                }
+            } else if (arg == "--compact-history" && i + 1 < argc) {
+                auto age = std::chrono::hours(24) * std::stoll(argv[++i]);
+                std::string archive = (i + 1 < argc && argv[i + 1][0] != '-') ? argv[++i] : "";
+                auto before = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    (std::chrono::system_clock::now() - age).time_since_epoch()).count();
+
+                long long archived = db.compactHistory(before, archive);
+                if (archived < 0) {
+                    std::cerr << "Ошибка сжатия истории.\n";
+                    return 1;
+                }
+                std::cout << "Перенесено записей истории: " << archived << "\n";
+                return 0;
+            } else if (arg == "--serve" && i + 1 < argc) {
+                serveAddress = argv[++i];
+            } else if (arg == "--workers" && i + 1 < argc) {
+                workers = static_cast<unsigned>(std::stoul(argv[++i]));
+            } else if (arg == "--record" && i + 1 < argc) {
+                tracePath = argv[++i];
+            } else {
+                std::cerr << "Неизвестный аргумент: " << arg << "\n";
+                return 1;
+            }
+        }
+
+        if (diagnose) {
+            int full_scans = 0;
+            for (const auto& diagnostic : db.diagnoseQueries()) {
+                std::cout << (diagnostic.full_scan ? "[ПОЛНЫЙ ПРОСМОТР] " : "[OK] ")
+                          << diagnostic.name << ": " << diagnostic.sql << "\n";
+                for (const auto& line : diagnostic.plan) {
+                    std::cout << "    " << line << "\n";
+                }
+                full_scans += diagnostic.full_scan ? 1 : 0;
+            }
+            std::cout << "Запросов с полным просмотром таблицы: " << full_scans << "\n";
+            return 0;
+        }
+
+        if (!serveAddress.empty()) {
+#ifdef INVENTORY_WITH_SERVER
+            if (workers == 0) {
+                workers = std::max(1u, std::thread::hardware_concurrency());
+            }
+
+            DatabasePool pool("data/school.db", workers, logger);
+            // Запросы сервера выполняют соединения пула, а не db
+            db.disableProfiling();
+            if (profileThreshold && !pool.enableProfiling("slow_queries.log", *profileThreshold)) {
+                std::cerr << "Не удалось включить профилирование запросов.\n";
+                return 1;
+            }
+            if (!tracePath.empty() && !pool.startRecording(tracePath)) {
+                std::cerr << "Не удалось создать файл трассы " << tracePath << "\n";
+                return 1;
+            }
+            Server server(pool, logger, workers);
+            if (!server.listen(serveAddress)) {
+                std::cerr << "Не удалось запустить сервер на " << serveAddress << "\n";
+                return 1;
+            }
+
+            runningServer = &server;
+            std::signal(SIGINT, stopServer);
+            std::signal(SIGTERM, stopServer);
+            std::cout << "Сервер запущен (" << workers << " рабочих потоков), Ctrl+C для остановки\n";
+            server.run();
+            runningServer = nullptr;
+            return 0;
+#else
+            std::cerr << "Режим сервера доступен только в Linux-сборке.\n";
+            return 1;
+#endif
+        }
+
+        if (!tracePath.empty() && !db.startRecording(tracePath)) {
+            std::cerr << "Не удалось создать файл трассы " << tracePath << "\n";
+            return 1;
+        }
+
         // Основной цикл программы: отображение меню и обработка выбора пользователя
         while (true) {
             // Выводим меню программы
@@ -71,16 +199,16 @@ int main() {
                     std::getline(std::cin, query);
 
                     // Выполняем поиск оборудования в базе данных
-                    auto results = db.searchEquipment(query);
+                    auto results = db.searchEquipmentRecords(query);
                     if (results.empty()) {
                         std::cout << "Оборудование не найдено.\n";
                     } else {
                         std::cout << "Результаты поиска:\n";
-                        for (const auto& row : results) {
+                        for (const auto& item : results) {
                             // Выводим найденные записи
-                            std::cout << "Наименование: " << row[0] << ", Количество: " << row[1]
-                                      << ", Инвентарный номер: " << row[2] << ", Кабинет: " << row[3]
-                                      << ", Ответственное лицо: " << row[4] << "\n";
+                            std::cout << "Наименование: " << item.name << ", Количество: " << item.quantity
+                                      << ", Инвентарный номер: " << item.inventory_number << ", Кабинет: " << item.room
+                                      << ", Ответственное лицо: " << item.responsible << "\n";
                         }
                     }
                     break;
@@ -1,6 +1,9 @@
 #include "../include/database.hpp"
 #include "../include/Logger.hpp"
 #include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
 
 // Тест для проверки создания таблиц
 TEST(DatabaseTest, Initialization) {
@@ -35,4 +38,205 @@ TEST(DatabaseTest, AddEquipment) {
     EXPECT_EQ(results[0][2], "INV-001");
     EXPECT_EQ(results[0][3], "101");
     EXPECT_EQ(results[0][4], "Иванов И.И.");
-}
\ No newline at end of file
+}
+
+// Тест для проверки журнала медленных запросов
+TEST(DatabaseTest, SlowQueryLog) {
+    Logger logger("test.log");
+    Database db(":memory:", logger); // Используем временную БД в памяти
+    ASSERT_TRUE(db.initialize());
+    ASSERT_TRUE(db.addEquipment("Стол", 5, "INV-001", "101", "Иванов И.И."));
+
+    // Нулевой порог: в журнал попадает каждый запрос
+    std::remove("test_slow.log");
+    ASSERT_TRUE(db.enableProfiling("test_slow.log", std::chrono::microseconds(0)));
+    db.diagnoseQueries();
+    auto results = db.searchEquipment("Стол");
+    db.disableProfiling();
+    ASSERT_EQ(results.size(), 1);
+
+    std::ifstream slowLog("test_slow.log");
+    std::string contents((std::istreambuf_iterator<char>(slowLog)), std::istreambuf_iterator<char>());
+    EXPECT_NE(contents.find("Медленный запрос"), std::string::npos);
+    EXPECT_NE(contents.find("строк: 1"), std::string::npos);
+    EXPECT_NE(contents.find("SCAN Equipment"), std::string::npos);
+    // Планы, построенные diagnoseQueries, сами медленными запросами не считаются
+    EXPECT_EQ(contents.find("SQL: EXPLAIN"), std::string::npos);
+}
+
+// Тест для проверки диагностики планов канонических запросов
+TEST(DatabaseTest, DiagnoseQueries) {
+    Logger logger("test.log");
+    Database db(":memory:", logger); // Используем временную БД в памяти
+    ASSERT_TRUE(db.initialize());
+
+    auto report = db.diagnoseQueries();
+    ASSERT_FALSE(report.empty());
+
+    for (const auto& diagnostic : report) {
+        if (diagnostic.name == "searchEquipment") {
+            // Поиск по подстроке не может использовать индекс
+            EXPECT_TRUE(diagnostic.full_scan);
+        } else if (diagnostic.name == "removeEquipment" || diagnostic.name.rfind("findEquipment", 0) == 0) {
+            // Удаление и выборки по кабинету/ответственному используют индексы
+            EXPECT_FALSE(diagnostic.full_scan) << diagnostic.name;
+        }
+    }
+}
+
+// Тест для проверки выборок по корпусу, назначению кабинета и ответственному
+TEST(DatabaseTest, IndexedQueries) {
+    Logger logger("test.log");
+    Database db(":memory:", logger); // Используем временную БД в памяти
+    ASSERT_TRUE(db.initialize());
+
+    ASSERT_TRUE(db.addEquipment("Вытяжной шкаф", 1, "INV-001", "13", "Петров П.П."));  // А, этаж 2, химия
+    ASSERT_TRUE(db.addEquipment("Штатив", 12, "INV-002", "22", "Петров П.П."));       // А, этаж 3, химия
+    ASSERT_TRUE(db.addEquipment("Карта", 3, "INV-003", "1", "Иванов И.И."));          // А, этаж 1, история
+    ASSERT_TRUE(db.addEquipment("Стол", 5, "INV-004", "101", "Иванов И.И."));         // Кабинета нет в Classrooms
+
+    auto floor2 = db.findEquipmentByLocation("A", 2);
+    ASSERT_EQ(floor2.size(), 1);
+    EXPECT_EQ(floor2[0][2], "INV-001");
+
+    EXPECT_EQ(db.findEquipmentByPurpose("Химия").size(), 2);
+    EXPECT_EQ(db.findEquipmentByResponsible("Иванов И.И.").size(), 2);
+
+    // Перенос в кабинет химии обновляет связь с Classrooms
+    ASSERT_TRUE(db.updateEquipment("INV-004", 5, "13", "Иванов И.И."));
+    EXPECT_EQ(db.findEquipmentByLocation("A", 2).size(), 2);
+}
+
+// Тест для проверки миграции БД, созданной до появления classroom_id
+TEST(DatabaseTest, MigrateLegacySchema) {
+    Logger logger("test.log");
+    Database db(":memory:", logger); // Используем временную БД в памяти
+
+    ASSERT_TRUE(db.execute(R"(
+        CREATE TABLE Equipment (
+            id INTEGER PRIMARY KEY AUTOINCREMENT,
+            name TEXT NOT NULL,
+            quantity INTEGER NOT NULL,
+            inventory_number TEXT UNIQUE,
+            room TEXT NOT NULL,
+            responsible TEXT NOT NULL
+        );
+        INSERT INTO Equipment (name, quantity, inventory_number, room, responsible)
+        VALUES ('Доска', 1, 'INV-001', '14', 'Сидоров С.С.');
+    )"));
+
+    ASSERT_TRUE(db.initialize());
+
+    auto floor2 = db.findEquipmentByLocation("A", 2);
+    ASSERT_EQ(floor2.size(), 1);
+    EXPECT_EQ(floor2[0][0], "Доска");
+
+    // Повторная инициализация не применяет миграцию снова
+    EXPECT_TRUE(db.initialize());
+}
+
+// Тест для проверки истории изменений и состава на момент времени
+TEST(DatabaseTest, EquipmentHistory) {
+    Logger logger("test.log");
+    Database db(":memory:", logger); // Используем временную БД в памяти
+    ASSERT_TRUE(db.initialize());
+
+    ASSERT_TRUE(db.setHistoryTime(1000));
+    ASSERT_TRUE(db.addEquipment("Стол", 5, "INV-001", "101", "Иванов И.И."));
+    ASSERT_TRUE(db.addEquipment("Шкаф", 1, "INV-002", "101", "Иванов И.И."));
+    ASSERT_TRUE(db.setHistoryTime(2000));
+    ASSERT_TRUE(db.updateEquipment("INV-001", 4, "102", "Петров П.П."));
+    ASSERT_TRUE(db.removeEquipment("INV-002"));
+    ASSERT_TRUE(db.setHistoryTime(3000));
+    ASSERT_TRUE(db.removeEquipment("INV-001"));
+    ASSERT_TRUE(db.addEquipment("Шкаф", 2, "INV-002", "103", "Петров П.П."));
+    ASSERT_TRUE(db.setHistoryTime(std::nullopt));
+
+    auto history = db.equipmentHistory("INV-001");
+    ASSERT_EQ(history.size(), 3);
+    EXPECT_EQ(history[0][0], "1000");
+    EXPECT_EQ(history[0][1], "I");
+    EXPECT_EQ(history[1][1], "U");
+    EXPECT_EQ(history[1][4], "102");
+    EXPECT_EQ(history[2][0], "3000");
+    EXPECT_EQ(history[2][1], "D");
+
+    EXPECT_TRUE(db.inventoryAsOf(999).empty());
+
+    auto atAdd = db.inventoryAsOf(1000);
+    ASSERT_EQ(atAdd.size(), 2);
+    EXPECT_EQ(atAdd[0][2], "INV-001");
+    EXPECT_EQ(atAdd[0][3], "101");
+    EXPECT_EQ(atAdd[0][4], "Иванов И.И.");
+    EXPECT_EQ(atAdd[1][2], "INV-002");
+
+    // Удаленный INV-001 виден до удаления, повторно добавленный INV-002 - только после
+    auto atUpdate = db.inventoryAsOf(2999);
+    ASSERT_EQ(atUpdate.size(), 1);
+    EXPECT_EQ(atUpdate[0][1], "4");
+    EXPECT_EQ(atUpdate[0][3], "102");
+
+    auto latest = db.inventoryAsOf(3000);
+    ASSERT_EQ(latest.size(), 1);
+    EXPECT_EQ(latest[0][2], "INV-002");
+    EXPECT_EQ(latest[0][3], "103");
+
+    // Без зафиксированного времени записи получают текущее время
+    ASSERT_TRUE(db.updateEquipment("INV-002", 3, "103", "Петров П.П."));
+    EXPECT_GT(std::stoll(db.equipmentHistory("INV-002").back()[0]), 3000);
+}
+
+// Тест для проверки того, что зафиксированное время истории не выходит за пределы соединения
+TEST(DatabaseTest, HistoryTimePerConnection) {
+    Logger logger("test.log");
+    std::remove("test_history_clock.db");
+    {
+        Database first("test_history_clock.db", logger);
+        Database second("test_history_clock.db", logger);
+        ASSERT_TRUE(first.initialize());
+
+        ASSERT_TRUE(first.setHistoryTime(1000));
+        ASSERT_TRUE(first.addEquipment("Стол", 5, "INV-001", "101", "Иванов И.И."));
+        ASSERT_TRUE(second.addEquipment("Шкаф", 1, "INV-002", "101", "Иванов И.И."));
+
+        EXPECT_EQ(second.equipmentHistory("INV-001")[0][0], "1000");
+        EXPECT_GT(std::stoll(first.equipmentHistory("INV-002")[0][0]), 1000);
+    }
+
+    // После закрытия соединения время снова текущее
+    Database reopened("test_history_clock.db", logger);
+    ASSERT_TRUE(reopened.updateEquipment("INV-001", 4, "102", "Иванов И.И."));
+    EXPECT_GT(std::stoll(reopened.equipmentHistory("INV-001").back()[0]), 1000);
+    std::remove("test_history_clock.db");
+}
+
+// Тест для проверки сжатия истории
+TEST(DatabaseTest, CompactHistory) {
+    Logger logger("test.log");
+    Database db(":memory:", logger); // Используем временную БД в памяти
+    ASSERT_TRUE(db.initialize());
+
+    ASSERT_TRUE(db.setHistoryTime(1000));
+    ASSERT_TRUE(db.addEquipment("Стол", 5, "INV-001", "101", "Иванов И.И."));
+    ASSERT_TRUE(db.setHistoryTime(2000));
+    ASSERT_TRUE(db.updateEquipment("INV-001", 4, "102", "Иванов И.И."));
+    ASSERT_TRUE(db.setHistoryTime(3000));
+    ASSERT_TRUE(db.updateEquipment("INV-001", 3, "103", "Иванов И.И."));
+    ASSERT_TRUE(db.addEquipment("Стул", 2, "INV-002", "101", "Иванов И.И."));
+    ASSERT_TRUE(db.removeEquipment("INV-002"));
+    std::int64_t cutoff = 3001;
+
+    // От INV-001 остается последняя запись, удаленный INV-002 уходит целиком
+    std::remove("test_history_archive.db");
+    EXPECT_EQ(db.compactHistory(cutoff, "test_history_archive.db"), 4);
+    EXPECT_EQ(db.equipmentHistory("INV-001").size(), 1);
+    EXPECT_TRUE(db.equipmentHistory("INV-002").empty());
+
+    auto now = db.inventoryAsOf(cutoff);
+    ASSERT_EQ(now.size(), 1);
+    EXPECT_EQ(now[0][3], "103");
+
+    // Архивные записи доступны в отдельной БД
+    Database archive("test_history_archive.db", logger);
+    EXPECT_TRUE(archive.tableExists("EquipmentHistory"));
+}
@@ -0,0 +1,121 @@
+#include "../include/database.hpp"
+#include "../include/Logger.hpp"
+#include <gtest/gtest.h>
+#include <vector>
+
+// Изменения отмененной транзакции не доставляются, зафиксированной - доставляются одной пачкой
+TEST(NotifyTest, RollbackDeliversNothing) {
+    Logger logger("test.log");
+    Database db(":memory:", logger); // Используем временную БД в памяти
+    ASSERT_TRUE(db.initialize());
+
+    std::vector<std::vector<ChangeEvent>> batches;
+    ASSERT_GT(db.subscribe("Equipment", [&](const std::vector<ChangeEvent>& events) { batches.push_back(events); }), 0);
+
+    ASSERT_TRUE(db.execute("BEGIN;"));
+    ASSERT_TRUE(db.addEquipment("Стол", 5, "INV-001", "101", "Иванов И.И."));
+    ASSERT_TRUE(db.updateEquipment("INV-001", 6, "13", "Иванов И.И."));
+    ASSERT_TRUE(db.execute("ROLLBACK;"));
+    db.waitForNotifications();
+    EXPECT_TRUE(batches.empty());
+
+    // Вставка с привязкой к кабинету дает одно событие
+    ASSERT_TRUE(db.addEquipment("Стул", 10, "INV-002", "101", "Иванов И.И."));
+    db.waitForNotifications();
+    ASSERT_EQ(batches.size(), 1u);
+    ASSERT_EQ(batches[0].size(), 1u);
+    EXPECT_EQ(batches[0][0].operation, ChangeEvent::INSERTED);
+    EXPECT_EQ(batches[0][0].table, "Equipment");
+    EXPECT_EQ(batches[0][0].room, "101");
+}
+
+// Подписчик на кабинет получает изменения, затрагивающие его до или после изменения
+TEST(NotifyTest, RoomFilter) {
+    Logger logger("test.log");
+    Database db(":memory:", logger); // Используем временную БД в памяти
+    ASSERT_TRUE(db.initialize());
+
+    std::vector<std::vector<ChangeEvent>> batches;
+    int id = db.subscribe("Equipment", [&](const std::vector<ChangeEvent>& events) { batches.push_back(events); }, "13");
+    ASSERT_GT(id, 0);
+
+    ASSERT_TRUE(db.execute("BEGIN;"));
+    ASSERT_TRUE(db.addEquipment("Стол", 5, "INV-001", "101", "Иванов И.И."));
+    ASSERT_TRUE(db.addEquipment("Стул", 10, "INV-002", "13", "Петров П.П."));
+    ASSERT_TRUE(db.execute("COMMIT;"));
+    db.waitForNotifications();
+    ASSERT_EQ(batches.size(), 1u);
+    ASSERT_EQ(batches[0].size(), 1u);
+    EXPECT_EQ(batches[0][0].room, "13");
+
+    // Перемещение из кабинета 13 в 101
+    ASSERT_TRUE(db.updateEquipment("INV-002", 10, "101", "Петров П.П."));
+    ASSERT_TRUE(db.removeEquipment("INV-001"));
+    db.waitForNotifications();
+    ASSERT_EQ(batches.size(), 2u);
+    ASSERT_EQ(batches[1].size(), 1u);
+    EXPECT_EQ(batches[1][0].operation, ChangeEvent::UPDATED);
+    EXPECT_EQ(batches[1][0].room, "101");
+    EXPECT_EQ(batches[1][0].previous_room, "13");
+
+    db.unsubscribe(id);
+    ASSERT_TRUE(db.updateEquipment("INV-002", 10, "13", "Петров П.П."));
+    db.waitForNotifications();
+    EXPECT_EQ(batches.size(), 2u);
+}
+
+// Пачка публикуется только после успешного COMMIT, а не при вызове хука фиксации
+TEST(NotifyTest, PublishAfterCommitCompletes) {
+    Logger logger("test.log");
+    ChangeNotifier notifier(logger);
+
+    std::vector<std::vector<ChangeEvent>> batches;
+    notifier.subscribe("Equipment", "", [&](const std::vector<ChangeEvent>& events) { batches.push_back(events); });
+
+    // COMMIT завершился SQLITE_BUSY: транзакция осталась открытой, затем отменена
+    notifier.recordChange(SQLITE_INSERT, "Equipment", 1);
+    notifier.commit();
+    notifier.settle(false);
+    notifier.waitIdle();
+    EXPECT_TRUE(batches.empty());
+    notifier.rollback();
+    notifier.settle(true);
+    notifier.waitIdle();
+    EXPECT_TRUE(batches.empty());
+
+    // Повторный COMMIT после SQLITE_BUSY доставляет изменения транзакции
+    notifier.recordChange(SQLITE_INSERT, "Equipment", 2);
+    notifier.commit();
+    notifier.settle(false);
+    notifier.recordChange(SQLITE_UPDATE, "Equipment", 2);
+    notifier.commit();
+    notifier.settle(true);
+    notifier.waitIdle();
+    ASSERT_EQ(batches.size(), 1u);
+    ASSERT_EQ(batches[0].size(), 1u);
+    EXPECT_EQ(batches[0][0].rowid, 2);
+    EXPECT_EQ(batches[0][0].operation, ChangeEvent::INSERTED);
+}
+
+// Ошибка следующего выражения execute не отменяет доставку уже зафиксированного
+TEST(NotifyTest, ExecuteKeepsCommittedStatement) {
+    Logger logger("test.log");
+    Database db(":memory:", logger); // Используем временную БД в памяти
+    ASSERT_TRUE(db.initialize());
+    ASSERT_TRUE(db.addEquipment("Стол", 5, "INV-DUP", "101", "Иванов И.И."));
+
+    std::vector<std::vector<ChangeEvent>> batches;
+    ASSERT_GT(db.subscribe("Equipment", [&](const std::vector<ChangeEvent>& events) { batches.push_back(events); }), 0);
+
+    EXPECT_FALSE(db.execute(
+        "INSERT INTO Equipment (name, quantity, inventory_number, room, responsible) "
+        "VALUES ('Стул', 1, 'INV-NEW', '101', 'Иванов И.И.');"
+        "INSERT INTO Equipment (name, quantity, inventory_number, room, responsible) "
+        "VALUES ('Шкаф', 1, 'INV-DUP', '101', 'Иванов И.И.');"));
+    db.waitForNotifications();
+
+    EXPECT_FALSE(db.getEquipment("INV-NEW").empty());
+    ASSERT_EQ(batches.size(), 1u);
+    ASSERT_EQ(batches[0].size(), 1u);
+    EXPECT_EQ(batches[0][0].operation, ChangeEvent::INSERTED);
+}
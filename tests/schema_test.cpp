@@ -0,0 +1,58 @@
+#include "../include/database.hpp"
+#include "../include/InventorySchema.hpp"
+#include "../include/Logger.hpp"
+#include <gtest/gtest.h>
+
+// Тексты запросов строятся на этапе компиляции
+static_assert(equipment::Insert::text ==
+              "INSERT INTO Equipment (name, quantity, inventory_number, room, responsible, classroom_id) "
+              "VALUES (?, ?, ?, ?, ?, (SELECT id FROM Classrooms WHERE room_number = ?4));");
+static_assert(equipment::Update::text ==
+              "UPDATE Equipment SET quantity = ?, room = ?, responsible = ?, "
+              "classroom_id = (SELECT id FROM Classrooms WHERE room_number = ?2) WHERE inventory_number = ?;");
+static_assert(equipment::Delete::text == "DELETE FROM Equipment WHERE inventory_number = ?;");
+static_assert(equipment::Search::text ==
+              "SELECT name, quantity, inventory_number, room, responsible FROM Equipment "
+              "WHERE name LIKE ?1 OR room LIKE ?1;");
+static_assert(equipment::SelectByLocation::text ==
+              "SELECT e.name, e.quantity, e.inventory_number, e.room, e.responsible "
+              "FROM Classrooms AS c JOIN Equipment AS e ON e.classroom_id = c.id "
+              "WHERE c.building = ? AND c.floor = ?;");
+static_assert(std::tuple_size<equipment::Update::parameters>::value == 4);
+
+// Аргументы привязки должны иметь ровно тип поля, без неявных преобразований
+using UpdateParams = schema::Params<equipment::Update::parameters>;
+static_assert(UpdateParams::exact<int, std::string, std::string, std::string>);
+static_assert(!UpdateParams::exact<int, const char*, std::string, std::string>);
+static_assert(!UpdateParams::exact<double, std::string, std::string, std::string>);
+
+// Тест для проверки сгенерированного DDL
+TEST(SchemaTest, CreateTable) {
+    EXPECT_EQ(classrooms::CreateTable::text,
+              "CREATE TABLE Classrooms (id INTEGER PRIMARY KEY AUTOINCREMENT, room_number TEXT NOT NULL UNIQUE, "
+              "building TEXT NOT NULL, floor INTEGER NOT NULL, purpose TEXT, responsible TEXT);");
+}
+
+// Тест для проверки типизированной привязки и чтения
+TEST(SchemaTest, TypedRoundTrip) {
+    Logger logger("test.log");
+    Database db(":memory:", logger); // Используем временную БД в памяти
+    ASSERT_TRUE(db.initialize());
+
+    // Значения передаются параметрами, кавычки в данных не ломают запрос
+    ASSERT_TRUE(db.addEquipment("Стол \"Школьник\"", 5, "INV-'001'", "13", "О'Коннор"));
+
+    auto records = db.searchEquipmentRecords("Школьник");
+    ASSERT_EQ(records.size(), 1);
+    EXPECT_EQ(records[0].name, "Стол \"Школьник\"");
+    EXPECT_EQ(records[0].quantity, 5);
+    EXPECT_EQ(records[0].inventory_number, "INV-'001'");
+    EXPECT_EQ(records[0].room, "13");
+    EXPECT_EQ(records[0].responsible, "О'Коннор");
+
+    ASSERT_TRUE(db.updateEquipment("INV-'001'", 7, "14", "О'Коннор"));
+    EXPECT_EQ(db.searchEquipmentRecords("Школьник")[0].quantity, 7);
+
+    ASSERT_TRUE(db.removeEquipment("INV-'001'"));
+    EXPECT_TRUE(db.searchEquipmentRecords("Школьник").empty());
+}
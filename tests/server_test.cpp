@@ -0,0 +1,170 @@
+#include "../include/DatabasePool.hpp"
+#include "../include/Logger.hpp"
+#include "../include/Protocol.hpp"
+#include "../include/Server.hpp"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+// Тест для проверки кодирования и разбора кадров протокола
+TEST(ServerTest, ProtocolRoundTrip) {
+    protocol::Request request{protocol::Op::Add, {"Стол", "5", "INV-001", "101", ""}};
+    std::string buffer = protocol::frame(protocol::encodeRequest(request));
+
+    // Неполный кадр не извлекается
+    std::string partial = buffer.substr(0, buffer.size() - 1);
+    std::string payload;
+    EXPECT_EQ(protocol::takeFrame(partial, payload), 0);
+
+    ASSERT_EQ(protocol::takeFrame(buffer, payload), 1);
+    EXPECT_TRUE(buffer.empty());
+
+    protocol::Request decoded;
+    ASSERT_TRUE(protocol::decodeRequest(payload, decoded));
+    EXPECT_EQ(decoded.op, protocol::Op::Add);
+    EXPECT_EQ(decoded.args, request.args);
+
+    // Обрезанное тело отвергается
+    EXPECT_FALSE(protocol::decodeRequest(payload.substr(0, payload.size() - 1), decoded));
+}
+
+// Тест для проверки запросов к серверу через Unix-сокет
+TEST(ServerTest, ServeRequests) {
+    const std::string dbPath = "test_server.db";
+    const std::string socketPath = "test_server.sock";
+    for (const char* suffix : {"", "-wal", "-shm"}) {
+        std::remove((dbPath + suffix).c_str());
+    }
+
+    Logger logger("test.log");
+    DatabasePool pool(dbPath, 2, logger);
+    Server server(pool, logger, 2);
+    ASSERT_TRUE(server.listen(socketPath));
+    std::thread loop([&] { server.run(); });
+
+    int fd = protocol::connectTo(socketPath);
+    ASSERT_GE(fd, 0);
+
+    protocol::Response response;
+    ASSERT_TRUE(protocol::call(fd, {protocol::Op::Add, {"Стол", "5", "INV-001", "101", "Иванов И.И."}}, response));
+    EXPECT_EQ(response.status, protocol::Status::Ok);
+
+    ASSERT_TRUE(protocol::call(fd, {protocol::Op::Update, {"INV-001", "7", "102", "Петров П.П."}}, response));
+    EXPECT_EQ(response.status, protocol::Status::Ok);
+
+    ASSERT_TRUE(protocol::call(fd, {protocol::Op::Get, {"INV-001"}}, response));
+    ASSERT_EQ(response.rows.size(), 1);
+    EXPECT_EQ(response.rows[0][1], "7");
+    EXPECT_EQ(response.rows[0][3], "102");
+
+    ASSERT_TRUE(protocol::call(fd, {protocol::Op::Search, {"Стол"}}, response));
+    EXPECT_EQ(response.rows.size(), 1);
+
+    // Ошибка в аргументах возвращается клиенту, соединение остается открытым
+    ASSERT_TRUE(protocol::call(fd, {protocol::Op::Update, {"INV-001", "много", "102", "Петров П.П."}}, response));
+    EXPECT_EQ(response.status, protocol::Status::Error);
+
+    ASSERT_TRUE(protocol::call(fd, {protocol::Op::Remove, {"INV-001"}}, response));
+    ASSERT_TRUE(protocol::call(fd, {protocol::Op::Get, {"INV-001"}}, response));
+    EXPECT_TRUE(response.rows.empty());
+
+    ::close(fd);
+    server.stop();
+    loop.join();
+}
+
+// Тест для проверки ответов на все запросы клиента, закончившего передачу
+TEST(ServerTest, DrainAfterClientShutdown) {
+    const std::string dbPath = "test_server.db";
+    const std::string socketPath = "test_server.sock";
+    for (const char* suffix : {"", "-wal", "-shm"}) {
+        std::remove((dbPath + suffix).c_str());
+    }
+
+    Logger logger("test.log");
+    DatabasePool pool(dbPath, 2, logger);
+    Server server(pool, logger, 2);
+    ASSERT_TRUE(server.listen(socketPath));
+    std::thread loop([&] { server.run(); });
+
+    int fd = protocol::connectTo(socketPath);
+    ASSERT_GE(fd, 0);
+
+    // Запросов больше, чем сервер держит в очереди одного клиента
+    const std::size_t count = Server::kMaxQueuedRequests * 2 + 1;
+    std::string frames;
+    for (std::size_t i = 0; i < count; ++i) {
+        std::string number = "INV-" + std::to_string(i);
+        frames += protocol::frame(protocol::encodeRequest({protocol::Op::Add, {"Стул", "1", number, "101", ""}}));
+    }
+    for (std::size_t sent = 0; sent < frames.size();) {
+        ssize_t n = ::send(fd, frames.data() + sent, frames.size() - sent, MSG_NOSIGNAL);
+        ASSERT_GT(n, 0);
+        sent += static_cast<std::size_t>(n);
+    }
+    ::shutdown(fd, SHUT_WR);
+
+    std::string input;
+    std::string payload;
+    std::size_t answered = 0;
+    char buffer[4096];
+    ssize_t n;
+    while ((n = ::read(fd, buffer, sizeof(buffer))) > 0) {
+        input.append(buffer, static_cast<std::size_t>(n));
+        while (protocol::takeFrame(input, payload) == 1) {
+            protocol::Response response;
+            ASSERT_TRUE(protocol::decodeResponse(payload, response));
+            EXPECT_EQ(response.status, protocol::Status::Ok);
+            ++answered;
+        }
+    }
+    EXPECT_EQ(answered, count);
+
+    ::close(fd);
+    server.stop();
+    loop.join();
+}
+
+// Тест для проверки номера порта в адресе
+TEST(ServerTest, RejectInvalidPort) {
+    std::uint16_t port = 1;
+    EXPECT_TRUE(protocol::parsePort("0", port));
+    EXPECT_EQ(port, 0);
+    EXPECT_TRUE(protocol::parsePort("65535", port));
+    EXPECT_EQ(port, 65535);
+    EXPECT_FALSE(protocol::parsePort("65536", port));
+    EXPECT_FALSE(protocol::parsePort("99999999999999999999999", port));
+
+    EXPECT_EQ(protocol::connectTo("0"), -1);
+    EXPECT_EQ(protocol::connectTo("70000"), -1);
+
+    Logger logger("test.log");
+    DatabasePool pool(":memory:", 1, logger);
+    Server server(pool, logger, 1);
+    EXPECT_FALSE(server.listen("70000"));
+}
+
+// Тест для проверки того, что путь с обычным файлом не удаляется ради Unix-сокета
+TEST(ServerTest, KeepExistingFileAtSocketPath) {
+    const char* path = "test_server_file.db";
+    {
+        std::ofstream file(path);
+        file << "данные";
+    }
+
+    Logger logger("test.log");
+    DatabasePool pool(":memory:", 1, logger);
+    {
+        Server server(pool, logger, 1);
+        EXPECT_FALSE(server.listen(path));
+    }
+
+    std::ifstream file(path);
+    std::string contents;
+    std::getline(file, contents);
+    EXPECT_EQ(contents, "данные");
+    std::remove(path);
+}
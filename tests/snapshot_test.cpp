@@ -0,0 +1,126 @@
+#include "../include/database.hpp"
+#include "../include/EquipmentSnapshot.hpp"
+#include "../include/Logger.hpp"
+#include <gtest/gtest.h>
+#include <limits>
+
+// Фильтры и группировка по столбцам снимка
+TEST(SnapshotTest, FilterAndGroup) {
+    Logger logger("test.log");
+    Database db(":memory:", logger); // Используем временную БД в памяти
+    ASSERT_TRUE(db.initialize());
+
+    ASSERT_TRUE(db.addEquipment("Вытяжной шкаф", 1, "INV-001", "13", "Петров П.П."));  // А, этаж 2, химия
+    ASSERT_TRUE(db.addEquipment("Штатив", 12, "INV-002", "22", "Петров П.П."));       // А, этаж 3, химия
+    ASSERT_TRUE(db.addEquipment("Колбы", 30, "INV-003", "22", "Иванов И.И."));        // А, этаж 3, химия
+    ASSERT_TRUE(db.addEquipment("Карта", 3, "INV-004", "1", "Иванов И.И."));          // А, этаж 1, история
+    ASSERT_TRUE(db.addEquipment("Стол", 5, "INV-005", "101", "Иванов И.И."));         // Кабинета нет в Classrooms
+
+    EquipmentSnapshot snapshot(db);
+    ASSERT_TRUE(snapshot.load());
+    EXPECT_EQ(snapshot.size(), 5u);
+
+    EquipmentSnapshot::Filter chemistry;
+    chemistry.purpose = "Химия";
+    chemistry.min_quantity = 11;
+    chemistry.responsible = "Петров П.П.";
+    auto totals = snapshot.totals(chemistry);
+    EXPECT_EQ(totals.items, 1u);
+    EXPECT_EQ(totals.quantity, 12);
+    EXPECT_EQ(snapshot.inventoryNumbers(chemistry), std::vector<std::string>{"INV-002"});
+
+    EquipmentSnapshot::Filter floor3;
+    floor3.building = "A";
+    floor3.floor = 3;
+    EXPECT_EQ(snapshot.totals(floor3).quantity, 42);
+
+    // Неизвестное значение не совпадает ни с одной строкой
+    EquipmentSnapshot::Filter unknown;
+    unknown.room = "999";
+    EXPECT_EQ(snapshot.totals(unknown).items, 0u);
+
+    auto byPurpose = snapshot.totalsBy(EquipmentSnapshot::PURPOSE, EquipmentSnapshot::Filter());
+    ASSERT_EQ(byPurpose.size(), 3u);
+    for (const auto& group : byPurpose) {
+        if (group.first == "Химия") {
+            EXPECT_EQ(group.second.quantity, 43);
+        } else if (group.first == "История") {
+            EXPECT_EQ(group.second.items, 1u);
+        } else {
+            EXPECT_EQ(group.first, ""); // Кабинет 101 без назначения
+        }
+    }
+}
+
+// Обновление снимка по отслеживанию изменений совпадает с полной загрузкой
+TEST(SnapshotTest, IncrementalRefresh) {
+    Logger logger("test.log");
+    Database db(":memory:", logger); // Используем временную БД в памяти
+    ASSERT_TRUE(db.initialize());
+    ASSERT_TRUE(db.addEquipment("Вытяжной шкаф", 1, "INV-001", "13", "Петров П.П."));
+    ASSERT_TRUE(db.addEquipment("Штатив", 12, "INV-002", "22", "Петров П.П."));
+    ASSERT_TRUE(db.addEquipment("Карта", 3, "INV-003", "1", "Иванов И.И."));
+
+    EquipmentSnapshot snapshot(db);
+    ASSERT_TRUE(snapshot.load());
+
+    ASSERT_TRUE(db.updateEquipment("INV-003", 20, "13", "Иванов И.И."));
+    ASSERT_TRUE(db.removeEquipment("INV-001"));
+    ASSERT_TRUE(db.addEquipment("Стол", 5, "INV-004", "22", "Сидоров С.С."));
+    ASSERT_TRUE(db.execute("UPDATE Classrooms SET purpose = 'Физика' WHERE room_number = '22';"));
+    ASSERT_TRUE(snapshot.refresh());
+
+    EquipmentSnapshot reloaded(db);
+    ASSERT_TRUE(reloaded.load());
+    ASSERT_EQ(snapshot.size(), 3u);
+    ASSERT_EQ(reloaded.size(), 3u);
+
+    for (const char* purpose : {"Химия", "Физика", "История"}) {
+        EquipmentSnapshot::Filter filter;
+        filter.purpose = purpose;
+        EXPECT_EQ(snapshot.totals(filter).items, reloaded.totals(filter).items) << purpose;
+        EXPECT_EQ(snapshot.totals(filter).quantity, reloaded.totals(filter).quantity) << purpose;
+    }
+
+    EquipmentSnapshot::Filter physics;
+    physics.purpose = "Физика";
+    EXPECT_EQ(snapshot.totals(physics).quantity, 17);
+}
+
+// Этаж 0 отличается от оборудования без кабинета, отвязанное от кабинета оборудование обновляется
+TEST(SnapshotTest, FloorZeroAndUnlinkedRooms) {
+    Logger logger("test.log");
+    Database db(":memory:", logger); // Используем временную БД в памяти
+    ASSERT_TRUE(db.initialize());
+    ASSERT_TRUE(db.execute("INSERT INTO Classrooms (room_number, building, floor, purpose) "
+                           "VALUES ('0', 'Б', 0, 'Склад');"));
+    ASSERT_TRUE(db.addEquipment("Стеллаж", 4, "INV-001", "0", "Петров П.П."));     // Б, этаж 0
+    ASSERT_TRUE(db.addEquipment("Стол", 5, "INV-002", "101", "Иванов И.И."));      // Кабинета нет в Classrooms
+    ASSERT_TRUE(db.addEquipment("Штатив", 12, "INV-003", "22", "Петров П.П."));    // А, этаж 3
+
+    EquipmentSnapshot snapshot(db);
+    ASSERT_TRUE(snapshot.load());
+
+    EquipmentSnapshot::Filter basement;
+    basement.floor = 0;
+    EXPECT_EQ(snapshot.inventoryNumbers(basement), std::vector<std::string>{"INV-001"});
+
+    EquipmentSnapshot::Filter lowest;
+    lowest.floor = std::numeric_limits<int>::min();
+    EXPECT_EQ(snapshot.totals(lowest).items, 0u);
+
+    // Переименование кабинета отвязывает его оборудование, удаление кабинета - тоже
+    ASSERT_TRUE(db.execute("UPDATE Classrooms SET room_number = '22а' WHERE room_number = '22';"));
+    ASSERT_TRUE(db.execute("DELETE FROM Classrooms WHERE room_number = '0';"));
+    ASSERT_TRUE(snapshot.refresh());
+
+    EXPECT_TRUE(snapshot.inventoryNumbers(basement).empty());
+    EquipmentSnapshot::Filter floor3;
+    floor3.floor = 3;
+    EXPECT_TRUE(snapshot.inventoryNumbers(floor3).empty());
+
+    auto byPurpose = snapshot.totalsBy(EquipmentSnapshot::PURPOSE, EquipmentSnapshot::Filter());
+    ASSERT_EQ(byPurpose.size(), 1u);
+    EXPECT_EQ(byPurpose[0].first, "");
+    EXPECT_EQ(byPurpose[0].second.items, 3u);
+}
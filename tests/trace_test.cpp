@@ -0,0 +1,60 @@
+#include "../include/database.hpp"
+#include "../include/Logger.hpp"
+#include "../include/Trace.hpp"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+// Вызовы Database записываются в трассу с аргументами и неубывающим временем
+TEST(TraceTest, RecordAndRead) {
+    Logger logger("test.log");
+    Database db(":memory:", logger); // Используем временную БД в памяти
+    ASSERT_TRUE(db.initialize());
+
+    std::remove("test_trace.bin");
+    ASSERT_TRUE(db.addEquipment("Шкаф", 1, "INV-000", "101", "Иванов И.И."));
+    ASSERT_TRUE(db.startRecording("test_trace.bin"));
+    ASSERT_TRUE(db.addEquipment("Стол", 5, "INV-001", "101", "Иванов И.И."));
+    db.getEquipment("INV-001");
+    db.searchEquipment("Стол");
+    ASSERT_TRUE(db.updateEquipment("INV-001", 6, "13", "Петров П.П."));
+    ASSERT_TRUE(db.removeEquipment("INV-001"));
+    db.stopRecording();
+    db.searchEquipment("не записывается");
+
+    // Снимок БД сделан до первой записанной операции
+    Database snapshot(trace::snapshotPath("test_trace.bin"), logger);
+    EXPECT_EQ(snapshot.getEquipment("INV-000").size(), 5u);
+    EXPECT_TRUE(snapshot.getEquipment("INV-001").empty());
+
+    std::vector<trace::Call> calls;
+    bool complete = false;
+    ASSERT_TRUE(trace::read("test_trace.bin", calls, complete));
+    EXPECT_TRUE(complete);
+    ASSERT_EQ(calls.size(), 5u);
+    EXPECT_EQ(calls[0].op, trace::Op::Add);
+    EXPECT_EQ(calls[0].args, (std::vector<std::string>{"Стол", "5", "INV-001", "101", "Иванов И.И."}));
+    EXPECT_EQ(calls[1].op, trace::Op::Get);
+    EXPECT_EQ(calls[2].op, trace::Op::Search);
+    EXPECT_EQ(calls[2].args, (std::vector<std::string>{"Стол"}));
+    EXPECT_EQ(calls[3].op, trace::Op::Update);
+    EXPECT_EQ(calls[3].args, (std::vector<std::string>{"INV-001", "6", "13", "Петров П.П."}));
+    EXPECT_EQ(calls[4].op, trace::Op::Remove);
+    for (std::size_t i = 1; i < calls.size(); ++i) {
+        EXPECT_GE(calls[i].time_us, calls[i - 1].time_us);
+    }
+
+    // Из оборванной трассы читаются полные записи, чужой файл не читается
+    std::ifstream in("test_trace.bin", std::ios::binary);
+    std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    std::ofstream("test_trace.bin", std::ios::binary | std::ios::trunc) << data.substr(0, data.size() - 1);
+    calls.clear();
+    ASSERT_TRUE(trace::read("test_trace.bin", calls, complete));
+    EXPECT_FALSE(complete);
+    ASSERT_EQ(calls.size(), 4u);
+    EXPECT_EQ(calls[3].op, trace::Op::Update);
+    std::ofstream("test_trace.bin", std::ios::binary | std::ios::trunc) << "not a trace";
+    EXPECT_FALSE(trace::read("test_trace.bin", calls, complete));
+}
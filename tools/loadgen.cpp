@@ -0,0 +1,155 @@
+#include "../include/LatencyStats.hpp" // Подключаем подсчет процентилей
+#include "../include/Protocol.hpp"     // Подключаем протокол обмена
+#include <atomic>                      // Для флага окончания замера
+#include <chrono>                      // Для замеров времени
+#include <iomanip>                     // Для форматирования вывода
+#include <iostream>                    // Для вывода результатов
+#include <random>                      // Для выбора запросов
+#include <string>                      // Для работы со строками
+#include <thread>                      // Для клиентских потоков
+#include <unistd.h>                    // Для close
+#include <vector>                      // Для замеров
+
+// Генератор нагрузки для режима --serve.
+// Для 1, 2, 4, ... N одновременных клиентов отправляет смесь запросов
+// (70% get, 25% search, 5% update) и выводит пропускную способность и процентили задержки.
+//
+// Запуск: inventory_loadgen <порт|путь_к_сокету> [макс_клиентов=8] [секунд_на_уровень=3] [записей=1000]
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Номер инвентаря, используемый генератором
+std::string itemNumber(int i) {
+    return "LOAD-" + std::to_string(i);
+}
+
+// Заполняет БД тестовыми записями; уже существующие номера пропускаются сервером с ошибкой
+bool seed(const std::string& address, int items) {
+    int fd = protocol::connectTo(address);
+    if (fd < 0) {
+        return false;
+    }
+
+    protocol::Response response;
+    for (int i = 0; i < items; ++i) {
+        protocol::Request request{protocol::Op::Add,
+                                  {"Предмет " + std::to_string(i), std::to_string(i % 50), itemNumber(i),
+                                   std::to_string(1 + i % 27), "МОЛ " + std::to_string(i % 100)}};
+        if (!protocol::call(fd, request, response)) {
+            ::close(fd);
+            return false;
+        }
+    }
+
+    ::close(fd);
+    return true;
+}
+
+// Поток одного клиента: отправляет запросы, пока не выставлен stop; false - связь прервана
+bool client(const std::string& address, int items, unsigned seedValue, const std::atomic<bool>& stop,
+            std::vector<double>& latencies) {
+    int fd = protocol::connectTo(address);
+    if (fd < 0) {
+        return false;
+    }
+
+    std::mt19937 random(seedValue);
+    std::uniform_int_distribution<int> item(0, items - 1);
+    std::uniform_int_distribution<int> kind(0, 99);
+    protocol::Response response;
+
+    while (!stop) {
+        int i = item(random);
+        int k = kind(random);
+        protocol::Request request;
+        if (k < 70) {
+            request = {protocol::Op::Get, {itemNumber(i)}};
+        } else if (k < 95) {
+            request = {protocol::Op::Search, {"Предмет " + std::to_string(i)}};
+        } else {
+            request = {protocol::Op::Update,
+                       {itemNumber(i), std::to_string(k), std::to_string(1 + i % 27), "МОЛ " + std::to_string(k)}};
+        }
+
+        auto start = Clock::now();
+        if (!protocol::call(fd, request, response)) {
+            ::close(fd);
+            return false;
+        }
+        latencies.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+    }
+
+    ::close(fd);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Использование: " << argv[0]
+                  << " <порт|путь_к_сокету> [макс_клиентов=8] [секунд_на_уровень=3] [записей=1000]\n";
+        return 1;
+    }
+
+    std::string address = argv[1];
+    int maxClients = argc > 2 ? std::stoi(argv[2]) : 8;
+    double seconds = argc > 3 ? std::stod(argv[3]) : 3.0;
+    int items = argc > 4 ? std::stoi(argv[4]) : 1000;
+
+    if (!seed(address, items)) {
+        std::cerr << "Не удалось подключиться к серверу " << address << "\n";
+        return 1;
+    }
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "клиентов   запросов/с     p50 мкс     p95 мкс     p99 мкс     max мкс\n";
+
+    std::vector<int> levels;
+    for (int clients = 1; clients < maxClients; clients *= 2) {
+        levels.push_back(clients);
+    }
+    levels.push_back(maxClients);
+
+    for (int clients : levels) {
+        std::atomic<bool> stop{false};
+        std::vector<std::vector<double>> latencies(clients);
+        std::vector<char> succeeded(clients, 0);
+        std::vector<std::thread> threads;
+
+        auto start = Clock::now();
+        for (int c = 0; c < clients; ++c) {
+            threads.emplace_back([&, c] {
+                succeeded[c] = client(address, items, static_cast<unsigned>(c + 1), stop, latencies[c]);
+            });
+        }
+
+        std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+        stop = true;
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+        std::vector<double> all;
+        for (auto& samples : latencies) {
+            all.insert(all.end(), samples.begin(), samples.end());
+        }
+        LatencySummary summary = summarizeLatencies(all);
+
+        std::cout << std::setw(8) << clients << std::setw(13) << summary.count / elapsed
+                  << std::setw(12) << summary.p50 << std::setw(12) << summary.p95
+                  << std::setw(12) << summary.p99 << std::setw(12) << summary.max << "\n";
+
+        for (char ok : succeeded) {
+            if (!ok) {
+                std::cerr << "Соединение с сервером прервано\n";
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
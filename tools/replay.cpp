@@ -0,0 +1,216 @@
+#include "../include/LatencyStats.hpp" // Подключаем подсчет процентилей
+#include "../include/Logger.hpp"       // Подключаем логгер
+#include "../include/Trace.hpp"        // Подключаем чтение трассы
+#include "../include/database.hpp"     // Подключаем класс Database
+#include <chrono>                      // Для замеров времени
+#include <cstdio>                      // Для std::remove
+#include <fstream>                     // Для проверки исходной БД
+#include <functional>                  // Для std::hash
+#include <iomanip>                     // Для форматирования вывода
+#include <iostream>                    // Для вывода результатов
+#include <string>                      // Для работы со строками
+#include <thread>                      // Для потоков воспроизведения
+#include <vector>                      // Для замеров
+
+// Воспроизведение трассы вызовов, записанной Database::startRecording (--record).
+// Трасса выполняется на копии БД: как можно быстрее или в записанном темпе (--paced),
+// при необходимости в N потоках, каждый со своим соединением. Вызовы с одним
+// инвентарным номером попадают в один поток и сохраняют порядок, поиски
+// распределяются по потокам по очереди. Выводит пропускную способность и процентили задержки.
+// Исходная БД - снимок, который --record снимает перед началом записи (<трасса>.db):
+// на БД в конечном состоянии добавления из трассы завершатся ошибкой уникальности
+// инвентарного номера.
+//
+// Запуск: inventory_replay <трасса> [исходная_БД] [--threads N] [--paced] [--copy путь]
+// По умолчанию исходная БД - <трасса>.db, 1 поток, копия - <исходная_БД>.replay.
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const char* const kOpNames[] = {"", "search", "get", "add", "update", "remove"};
+constexpr int kOpCount = 6;
+
+// Замеры одного потока
+struct ThreadResult {
+    std::vector<double> latencies[kOpCount]; // Задержки вызовов по операциям, мкс
+    std::vector<double> lag;                 // Отставание от записанного темпа, мкс
+    long long failed = 0;                    // Вызовы, завершившиеся ошибкой
+};
+
+// Создает копию БД через VACUUM INTO: в копию попадает и содержимое WAL
+bool copyDatabase(const std::string& source, const std::string& copy, Logger& logger) {
+    if (!std::ifstream(source).good()) {
+        std::cerr << "Исходная БД не найдена: " << source << "\n";
+        return false;
+    }
+    for (const char* suffix : {"", "-wal", "-shm"}) {
+        std::remove((copy + suffix).c_str());
+    }
+
+    Database db(source, logger);
+    return db.backupTo(copy);
+}
+
+// Выполняет один вызов трассы; false - неверные аргументы или ошибка Database
+bool perform(Database& db, const trace::Call& call) {
+    const auto& a = call.args;
+    try {
+        switch (call.op) {
+            case trace::Op::Search:
+                return a.size() == 1 && (db.searchEquipment(a[0]), true);
+            case trace::Op::Get:
+                return a.size() == 1 && (db.getEquipment(a[0]), true);
+            case trace::Op::Add:
+                return a.size() == 5 && db.addEquipment(a[0], std::stoi(a[1]), a[2], a[3], a[4]);
+            case trace::Op::Update:
+                return a.size() == 4 && db.updateEquipment(a[0], std::stoi(a[1]), a[2], a[3]);
+            case trace::Op::Remove:
+                return a.size() == 1 && db.removeEquipment(a[0]);
+        }
+    } catch (const std::exception&) {
+        // Нечисловое количество
+    }
+    return false;
+}
+
+// Поток воспроизведения: выполняет свою часть вызовов по порядку
+void replayPart(const std::string& path, const std::vector<const trace::Call*>& calls, bool paced,
+                Clock::time_point start, Logger& logger, ThreadResult& result) {
+    Database db(path, logger);
+
+    for (const trace::Call* call : calls) {
+        if (paced) {
+            auto due = start + std::chrono::microseconds(call->time_us);
+            std::this_thread::sleep_until(due);
+            result.lag.push_back(std::chrono::duration<double, std::micro>(Clock::now() - due).count());
+        }
+
+        auto begin = Clock::now();
+        if (!perform(db, *call)) {
+            ++result.failed;
+        }
+        result.latencies[static_cast<int>(call->op)].push_back(
+            std::chrono::duration<double, std::micro>(Clock::now() - begin).count());
+    }
+}
+
+void printRow(const std::string& name, std::vector<double>& samples, double elapsed) {
+    LatencySummary summary = summarizeLatencies(samples);
+    std::cout << std::setw(8) << name << std::setw(10) << summary.count << std::setw(13) << summary.count / elapsed
+              << std::setw(12) << summary.p50 << std::setw(12) << summary.p95 << std::setw(12) << summary.p99
+              << std::setw(12) << summary.max << "\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Использование: " << argv[0]
+                  << " <трасса> [исходная_БД] [--threads N] [--paced] [--copy путь]\n";
+        return 1;
+    }
+
+    std::string tracePath = argv[1];
+    int next = 2;
+    std::string source = argc > 2 && argv[2][0] != '-' ? argv[next++] : trace::snapshotPath(tracePath);
+    std::string copy = source + ".replay";
+    unsigned threads = 1;
+    bool paced = false;
+    for (int i = next; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc) {
+            threads = static_cast<unsigned>(std::stoul(argv[++i]));
+        } else if (arg == "--paced") {
+            paced = true;
+        } else if (arg == "--copy" && i + 1 < argc) {
+            copy = argv[++i];
+        } else {
+            std::cerr << "Неизвестный аргумент: " << arg << "\n";
+            return 1;
+        }
+    }
+    if (threads == 0) {
+        threads = 1;
+    }
+
+    std::vector<trace::Call> calls;
+    bool complete = true;
+    if (!trace::read(tracePath, calls, complete)) {
+        std::cerr << "Не удалось прочитать трассу: " << tracePath << "\n";
+        return 1;
+    }
+    if (!complete) {
+        std::cerr << "Предупреждение: трасса оборвана, воспроизводятся " << calls.size()
+                  << " полных записей\n";
+    }
+
+    Logger logger("replay.log");
+    if (!copyDatabase(source, copy, logger)) {
+        std::cerr << "Не удалось скопировать БД в " << copy << "\n";
+        return 1;
+    }
+    {
+        // WAL, чтобы потоки-читатели не ждали писателя; initialize применяет миграции к старой БД
+        Database db(copy, logger);
+        if (!db.execute("PRAGMA journal_mode = WAL;") || !db.initialize()) {
+            std::cerr << "Не удалось подготовить копию БД " << copy << "\n";
+            return 1;
+        }
+    }
+
+    // Вызовы одного инвентарного номера - в одном потоке, поиски - по очереди
+    std::vector<std::vector<const trace::Call*>> parts(threads);
+    std::size_t searches = 0;
+    for (const auto& call : calls) {
+        std::size_t part = call.op == trace::Op::Search || call.args.empty()
+            ? searches++
+            : std::hash<std::string>()(call.op == trace::Op::Add && call.args.size() > 2 ? call.args[2] : call.args[0]);
+        parts[part % threads].push_back(&call);
+    }
+
+    std::vector<ThreadResult> results(threads);
+    std::vector<std::thread> workers;
+    auto start = Clock::now();
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back(replayPart, std::cref(copy), std::cref(parts[t]), paced, start, std::ref(logger),
+                             std::ref(results[t]));
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::vector<double> all, lag;
+    long long failed = 0;
+    std::cout << "Вызовов: " << calls.size() << ", потоков: " << threads
+              << (paced ? ", в записанном темпе" : ", максимальная скорость") << ", время " << std::fixed
+              << std::setprecision(3) << elapsed << " с\n";
+    std::cout << std::setprecision(1)
+              << "операция    вызовов     вызовов/с     p50 мкс     p95 мкс     p99 мкс     max мкс\n";
+    for (int op = 1; op < kOpCount; ++op) {
+        std::vector<double> samples;
+        for (auto& result : results) {
+            samples.insert(samples.end(), result.latencies[op].begin(), result.latencies[op].end());
+        }
+        all.insert(all.end(), samples.begin(), samples.end());
+        if (!samples.empty()) {
+            printRow(kOpNames[op], samples, elapsed);
+        }
+    }
+    for (auto& result : results) {
+        lag.insert(lag.end(), result.lag.begin(), result.lag.end());
+        failed += result.failed;
+    }
+    printRow("всего", all, elapsed);
+
+    if (paced) {
+        LatencySummary summary = summarizeLatencies(lag);
+        std::cout << "Отставание от записанного темпа: p50 " << summary.p50 << " мкс, p99 " << summary.p99
+                  << " мкс, max " << summary.max << " мкс\n";
+    }
+    if (failed > 0) {
+        std::cout << "Вызовов с ошибкой: " << failed << "\n";
+    }
+    return 0;
+}